@@ -0,0 +1,97 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Monotonic bump allocator backed by one slab sized up front. Allocations never
+// free individual blocks: the whole arena is released at once when it is
+// destroyed. Requests that do not fit the slab get an overflow chunk, so a
+// wrong size estimate costs memory, never correctness.
+class Arena
+{
+   public:
+    explicit Arena(size_t slab_bytes);
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    // Returns a block of the given size and alignment
+    void *allocate(size_t bytes, size_t alignment);
+
+    // Bytes obtained from the system (slab plus overflow chunks)
+    size_t get_reserved_bytes() const;
+
+    // Bytes handed out by allocate(), including alignment padding
+    size_t get_used_bytes() const;
+
+    // Number of chunks allocated (1 when the slab estimate was enough)
+    size_t get_chunk_count() const;
+
+   private:
+    std::vector<std::unique_ptr<char[]>> chunks;
+    char *cursor = nullptr;
+    size_t remaining = 0;
+    size_t reserved_bytes = 0;
+    size_t used_bytes = 0;
+
+    // Helper function to start a new chunk of at least the given size
+    void add_chunk(size_t bytes);
+};
+
+// Standard allocator drawing from an Arena. A default-constructed allocator
+// (no arena) falls back to the global heap. Blocks taken from an arena are
+// never returned individually, so deallocate() does not touch the arena and
+// containers may outlive it as long as they are not grown afterwards. The
+// allocator follows its container on move and swap, keeping the lists of a
+// graph in its slab when they are moved around.
+template <typename T>
+class ArenaAllocator
+{
+   public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    ArenaAllocator() = default;
+    explicit ArenaAllocator(Arena *arena) : arena(arena) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) : arena(other.get_arena())
+    {
+    }
+
+    T *allocate(size_t count)
+    {
+        if (arena)
+            return static_cast<T *>(arena->allocate(count * sizeof(T), alignof(T)));
+        return std::allocator<T>().allocate(count);
+    }
+
+    void deallocate(T *pointer, size_t count)
+    {
+        if (!arena)
+            std::allocator<T>().deallocate(pointer, count);
+    }
+
+    Arena *get_arena() const { return arena; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U> &other) const
+    {
+        return arena == other.get_arena();
+    }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U> &other) const
+    {
+        return arena != other.get_arena();
+    }
+
+   private:
+    Arena *arena = nullptr;
+};
+
+#endif  // ARENA_HPP
@@ -0,0 +1,14 @@
+#ifndef BOYKOV_KOLMOGOROV_HPP
+#define BOYKOV_KOLMOGOROV_HPP
+
+#include "ford_fulk.hpp"
+
+// Boykov-Kolmogorov max-flow. Two search trees are grown from the source and
+// from the sink over residual arcs until they touch, the path through the
+// touching arc is augmented, and the trees are repaired (orphans adopt a new
+// parent from the same tree or are freed) instead of being rebuilt, so later
+// searches reuse most of the previous work. Works best on short-path, grid-like
+// graphs (Mesh, RLevel, SquareMesh).
+FordResult boykov_kolmogorov(Graph &graph, int source, int sink, bool should_get_stats);
+
+#endif  // BOYKOV_KOLMOGOROV_HPP
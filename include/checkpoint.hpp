@@ -0,0 +1,133 @@
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Header written in front of the residual capacities of a checkpoint file
+struct CheckpointFileHeader {
+    char magic[8];         // "FFCKPT"
+    uint32_t version;      // Format version
+    uint32_t num_arcs;     // Number of residual capacities following the header
+    uint64_t fingerprint;  // get_fingerprint() of the graph being solved
+    int32_t max_flow;      // Flow sent when the checkpoint was taken
+    int32_t iterations;    // Augmentations done when the checkpoint was taken
+};
+
+// Progress of an augmenting path solve
+struct SolveProgress {
+    int max_flow = 0;
+    int iterations = 0;
+};
+
+// Periodically saves the residual capacities of an augmenting path solve and
+// the flow sent so far, so a crashed or preempted solve can resume from them.
+// The solve thread only copies the capacities (one pass over the arcs); a
+// background thread writes the copy to <path>.tmp and renames it over <path>,
+// so the file on disk is always a whole checkpoint. A checkpoint falling due
+// while the previous one is still being written is retried at the next
+// iteration instead of waiting for it.
+//
+// Works with any graph providing get_fingerprint(), save_residual() and
+// load_residual() (Graph and CompressedGraph). Checkpoints are tied to the
+// layout and vertex order they were taken with.
+class Checkpointer
+{
+   public:
+    // Checkpoints every_iterations augmentations or every_seconds seconds
+    // after the previous one, whichever comes first (0 disables either)
+    Checkpointer(const std::string &path, int every_iterations, double every_seconds);
+
+    // Waits for the checkpoint being written, if any
+    ~Checkpointer();
+
+    Checkpointer(const Checkpointer &) = delete;
+    Checkpointer &operator=(const Checkpointer &) = delete;
+
+    // Restores the residual capacities saved in the file into the graph.
+    // Returns false, leaving the graph untouched, if the file is missing,
+    // malformed or was taken on another graph.
+    template <typename GraphType>
+    bool resume(GraphType &graph)
+    {
+        std::vector<int> residual;
+        if (!read(graph.get_fingerprint(), residual))
+            return false;
+        graph.load_residual(residual);
+        return true;
+    }
+
+    // Progress saved in the file read by resume() (nothing sent otherwise)
+    const SolveProgress &get_resumed() const;
+
+    // Called after every augmentation: hands a copy of the residual
+    // capacities to the writer once a checkpoint is due and it is idle
+    template <typename GraphType>
+    void tick(const GraphType &graph, const SolveProgress &progress)
+    {
+        if (!is_due(progress.iterations) || !is_idle())
+            return;
+        if (!has_fingerprint) {
+            fingerprint = graph.get_fingerprint();
+            has_fingerprint = true;
+        }
+        graph.save_residual(snapshot);
+        submit(progress);
+    }
+
+    // Blocks until the checkpoint being written, if any, is on disk
+    void wait();
+
+    // Number of checkpoints written / that failed to be written
+    int get_written() const;
+    int get_failed() const;
+
+   private:
+    std::string path;
+    int every_iterations;
+    double every_seconds;
+
+    SolveProgress resumed;  // Progress read by resume()
+    uint64_t fingerprint = 0;
+    bool has_fingerprint = false;
+
+    int last_iterations = 0;  // Iterations at the last checkpoint (or resume)
+    std::chrono::steady_clock::time_point last_time;
+
+    // Shared with the writer thread, guarded by mutex
+    std::vector<int> snapshot;  // Residual capacities being written
+    SolveProgress pending_progress;
+    bool pending = false;   // A snapshot is waiting for or being written
+    bool stopping = false;  // The writer must exit once idle
+    int written = 0;
+    int failed = 0;
+    mutable std::mutex mutex;
+    std::condition_variable changed;
+    std::thread writer;
+
+    // Helper function to check whether a checkpoint is due
+    bool is_due(int iterations) const;
+
+    // Helper function to check whether the writer has no snapshot to write
+    bool is_idle() const;
+
+    // Helper function to hand the snapshot to the writer
+    void submit(const SolveProgress &progress);
+
+    // Helper function to read a checkpoint of the graph with the given
+    // fingerprint
+    bool read(uint64_t expected_fingerprint, std::vector<int> &residual);
+
+    // Body of the writer thread
+    void write_loop();
+
+    // Helper function to write the snapshot to <path>.tmp and rename it
+    bool write_file(const SolveProgress &progress) const;
+};
+
+#endif  // CHECKPOINT_HPP
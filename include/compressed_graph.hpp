@@ -0,0 +1,121 @@
+#ifndef COMPRESSED_GRAPH_HPP
+#define COMPRESSED_GRAPH_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "graph.hpp"
+
+// Residual graph for inputs whose Edge lists do not fit in memory. Every vertex
+// keeps the sorted, distinct heads of its arcs (an input arc in either
+// direction gives both endpoints an arc, as in Graph) as a list of varints:
+// the first head as the zigzag-encoded difference to the vertex, every other
+// one as the gap to the previous head minus one. Varints are LEB128, 7 bits
+// per byte with the high bit set on all but the last, so nearby heads take a
+// single byte. Residual and saved capacities live in their own arrays.
+//
+// Arc ids follow Graph's scheme (arcs of vertex v are first_arc[v] ..
+// first_arc[v + 1] - 1), in head order. Searches decode the lists as they walk
+// them through visit_arcs; the head, tail and reverse of a single arc are only
+// looked up on augmenting path arcs. Self-loops are dropped, since they never
+// carry flow, and critical arcs are not counted.
+class CompressedGraph
+{
+   public:
+    // Reads a DIMACS graph with a single source and sink from an input stream,
+    // without building Edge lists (throws std::invalid_argument on terminal
+    // sets)
+    CompressedGraph(std::istream &in);
+
+    // Calls visit(arc, head, residual capacity) for every arc leaving a vertex,
+    // in head order, until it returns false
+    template <typename Visitor>
+    void visit_arcs(int vertex, Visitor &&visit) const
+    {
+        const uint8_t *p = neighbors.data() + offsets[vertex];
+        const ArcId end = first_arc[vertex + 1];
+        ArcId arc = first_arc[vertex];
+        if (arc == end)
+            return;
+        int head = vertex + unzigzag(read_varint(p));
+        while (visit(arc, head, capacity[arc]) && ++arc < end) head += 1 + read_varint(p);
+    }
+
+    // Retrieves the residual capacity of an arc
+    int get_residual(ArcId arc) const { return capacity[arc]; }
+
+    // Retrieves the vertex an arc leaves from (binary search over first_arc)
+    int get_arc_tail(ArcId arc) const;
+
+    // Retrieves the vertex an arc enters, decoding the list of its tail
+    int get_arc_head(ArcId arc) const;
+
+    // Retrieves the arc in the opposite direction, decoding the list of its head
+    ArcId get_reverse(ArcId arc) const;
+
+    // Moves flow units along an arc: its residual capacity shrinks and the one
+    // of its reverse grows
+    void push_flow(ArcId arc, int flow);
+
+    // Same bound as Graph::compute_upper_flow_bound(source, sink)
+    int compute_upper_flow_bound(int source, int sink) const;
+
+    // Restores the capacities read from the input
+    void reset_residual();
+
+    // Same as Graph::save_residual, load_residual and get_fingerprint (the
+    // fingerprint hashes the encoded lists, so it differs from Graph's)
+    void save_residual(std::vector<int> &residual) const;
+    void load_residual(const std::vector<int> &residual);
+    uint64_t get_fingerprint() const;
+
+    // Bytes taken by the varint lists and the per-vertex offsets and arc ids
+    size_t get_topology_bytes() const;
+
+    // Bytes taken by the residual and saved capacities
+    size_t get_capacity_bytes() const;
+
+    // Bytes Graph takes for the same arcs: an Edge, a saved capacity and an arc
+    // tail per arc, plus a list header and a first arc per vertex
+    size_t get_uncompressed_bytes() const;
+
+    // Retrieves the source / sink vertex of the graph
+    int get_source() const;
+    int get_sink() const;
+
+    // Retrieves the total number of vertices in the graph
+    int get_total_vertices() const;
+
+    // Retrieves the total number of arcs, counted as Graph counts them
+    int get_total_arcs() const;
+
+   private:
+    std::vector<uint8_t> neighbors;        // Varint head lists, one vertex after the other
+    std::vector<uint64_t> offsets;         // Start of every list in neighbors (n + 1 entries)
+    std::vector<ArcId> first_arc;          // First arc id of every vertex (n + 1 entries)
+    std::vector<int> capacity;             // Residual capacity of every arc
+    std::vector<int> original_capacities;  // Capacities restored by reset_residual()
+
+    unsigned num_vertices_;
+    unsigned num_arcs_;
+    int source;
+    int sink;
+
+    // Reads one varint, moving p past it
+    static uint32_t read_varint(const uint8_t *&p)
+    {
+        uint32_t value = *p & 0x7f;
+        for (int shift = 7; *p++ & 0x80; shift += 7)
+            value |= static_cast<uint32_t>(*p & 0x7f) << shift;
+        return value;
+    }
+
+    // Maps 0, 1, 2, 3, 4... back to 0, -1, 1, -2, 2...
+    static int unzigzag(uint32_t value)
+    {
+        return static_cast<int>(value >> 1) ^ -static_cast<int>(value & 1);
+    }
+};
+
+#endif  // COMPRESSED_GRAPH_HPP
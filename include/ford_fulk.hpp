@@ -3,14 +3,21 @@
 
 #include <chrono>
 #include <functional>
+#include <limits>
 
+#include "checkpoint.hpp"
+#include "iteration_trace.hpp"
 #include "path_finding.hpp"
+#include "perf_counters.hpp"
 
 // Alias for a function pointer type that represents the search function used in
 // the Ford-Fulkerson algorithm. It takes a graph, a source vertex, and a sink
 // vertex as inputs, and returns a FlowPath.
 using SearchFunction = std::function<FlowPath(Graph &, int, int)>;
 
+// Target flow of a solve that must run to the maximum
+constexpr int NO_TARGET = std::numeric_limits<int>::max();
+
 // Enum representing the available Ford-Fulkerson algorithm types.
 enum class Algorithm {
     // A randomized version of the Ford-Fulkerson method using DFS
@@ -22,20 +29,40 @@ enum class Algorithm {
 
     // A variation that uses the fattest-path strategy, finding paths
     // with the highest residual capacity
-    FattestPath
+    FattestPath,
+
+    // Edmonds-Karp with a parallel level-synchronous BFS
+    ParallelEdmondsKarp,
+
+    // Multi-threaded push-relabel (not an augmenting path method)
+    ParallelPushRelabel,
+
+    // Boykov-Kolmogorov: augmenting paths found by two persistent search trees
+    BoykovKolmogorov,
+
+    // Hochbaum's highest-label pseudoflow (returns the minimum cut directly)
+    Pseudoflow
 };
 
-// Structure holding statistics about each iteration during the execution of the
-// Ford-Fulkerson algorithm.
-struct IterationStats {
-    std::vector<double> s_per_iter;  // s_i = n′_i / n: fraction of vertices visited per iteration
-    std::vector<double> t_per_iter;  // t_i = m′_i / m: fraction of arcs visited per iteration
-    std::vector<int> path_lengths_per_iter;  // ℓ_i: length of each augmenting path
-
-    // Normalized heap operation stats for Fattest Path
-    std::vector<double> inserts_per_iter;      // iᵢ = insertsᵢ / n
-    std::vector<double> deletemaxes_per_iter;  // dᵢ = deletemaxesᵢ / n
-    std::vector<double> updates_per_iter;      // uᵢ = updatesᵢ / m
+// Counters reported by the push-relabel engine
+struct PushRelabelStats {
+    int threads = 1;                // Number of worker threads
+    long long pushes = 0;           // Total number of pushes
+    long long relabels = 0;         // Total number of (local) relabels
+    long long global_relabels = 0;  // Number of global relabel passes
+};
+
+// Counters reported by the Boykov-Kolmogorov engine
+struct BoykovKolmogorovStats {
+    long long orphans = 0;    // Vertices cut from a tree by a saturated tree arc
+    long long adoptions = 0;  // Orphans that found a new parent in the same tree
+};
+
+// Counters reported by the pseudoflow engine
+struct PseudoflowStats {
+    long long merges = 0;    // Strong trees merged into a lower tree
+    long long splits = 0;    // Subtrees split off at a saturated tree arc
+    long long relabels = 0;  // Label increments
 };
 
 // Structure holding the result of the Ford-Fulkerson algorithm, including the
@@ -46,22 +73,78 @@ struct FordResult {
     int iterations;         // The total number of augmenting iterations performed
     long long duration_ms;  // Total time taken for the algorithm in milliseconds
 
-    IterationStats stats;  // Statistics gathered during each iteration of the algorithm
+    IterationTrace stats;  // Records gathered during each iteration of the algorithm
+
+    PushRelabelStats push_relabel = {};  // Push-relabel counters (ParallelPushRelabel only)
+    BoykovKolmogorovStats boykov_kolmogorov = {};  // Tree repair counters (BoykovKolmogorov only)
+    PseudoflowStats pseudoflow = {};               // Merge/split counters (Pseudoflow only)
+
+    std::vector<char> source_side = {};  // Source side of a minimum cut per vertex (Pseudoflow only)
 };
 
 // The main Ford-Fulkerson algorithm that runs the selected algorithm on the
 // graph and computes the maximum flow. It takes the graph, source, sink,
 // algorithm type, and whether or not to collect per-iteration statistics.
+// If perf is given, hardware counters are charged to the Search and Augment
+// phases. The seed drives the generator of a randomized search. Augmenting
+// stops once the flow reaches target, or before the first search if the
+// bound on the flow is already below it. If checkpoint is given, the solve
+// continues from the progress it resumed (if any) and offers it the residual
+// graph after every augmentation.
 FordResult ford_fulkerson(Graph &graph, int source, int sink, Algorithm algo,
-                          bool should_get_stats);
+                          bool should_get_stats, PerfCounters *perf = nullptr,
+                          uint64_t seed = DEFAULT_SEED,
+                          int target = NO_TARGET, Checkpointer *checkpoint = nullptr);
 
-// A utility function that returns the appropriate search function based on the
-// selected algorithm type.
-SearchFunction get_search_function(Algorithm algo);
+// Same augmenting loop on a compressed graph, for the two searches it supports
+// (Edmonds-Karp and Fattest Path; throws std::invalid_argument otherwise)
+FordResult ford_fulkerson(CompressedGraph &graph, int source, int sink, Algorithm algo,
+                          bool should_get_stats, Checkpointer *checkpoint = nullptr);
+
+// Runs the selected algorithm on the graph and computes the maximum flow.
+// Augmenting path algorithms go through ford_fulkerson, the remaining engines
+// through their own solver. Unit-capacity bipartite graphs are handed to
+// Hopcroft-Karp instead of an augmenting path algorithm when no statistics are
+// requested.
+// Passing ALL_TERMINALS as source and sink solves the multi-terminal problem
+// of the graph, which only the augmenting path algorithms support (throws
+// std::invalid_argument otherwise).
+FordResult solve_max_flow(Graph &graph, int source, int sink, Algorithm algo,
+                          bool should_get_stats, PerfCounters *perf = nullptr,
+                          uint64_t seed = DEFAULT_SEED);
+
+// Decision version of solve_max_flow: the max flow reaches target if and only
+// if result.max_flow >= target. Nothing is searched when the cuts around the
+// terminals (compute_upper_flow_bound) already rule the target out, and the
+// augmenting path algorithms stop as soon as the flow reaches it; otherwise
+// the failed search that ends them is the cut proving it unreachable. The
+// flow reported is then only a lower bound on the max flow.
+FordResult solve_max_flow_until(Graph &graph, int source, int sink, Algorithm algo, int target,
+                                bool should_get_stats, uint64_t seed = DEFAULT_SEED);
+
+// Solves the max flow of every (source, sink) pair on the same topology, in
+// parallel: each OpenMP thread resets and solves its own residual copy (the
+// first thread reuses the graph itself). Results follow the order of the pairs;
+// pair i is solved with seed + i, whichever thread takes it.
+std::vector<FordResult> solve_max_flow_batch(Graph &graph,
+                                             const std::vector<std::pair<int, int>> &pairs,
+                                             Algorithm algo, uint64_t seed = DEFAULT_SEED);
 
-// A utility function that stores the per-iteration statistics for the given
-// algorithm execution. It collects the path statistics for each iteration and
-// stores them in the IterationStats object.
-void store_iteration_stats(IterationStats &stats, const PathStats &path_stats, int n, int m);
+// Source side of a minimum cut once a max-flow solve has finished: the cut
+// reported by the engine (Pseudoflow) or the vertices still reachable from the
+// source in the residual graph.
+std::vector<char> min_cut_source_side(Graph &graph, int source, const FordResult &result);
+
+// Whether an algorithm can solve multi-terminal graphs (ALL_TERMINALS)
+bool supports_terminal_sets(Algorithm algo);
+
+// Whether an algorithm runs ford_fulkerson's augmenting path loop, which can be
+// stopped at a target flow and checkpointed
+bool has_augmenting_loop(Algorithm algo);
+
+// A utility function that returns the appropriate search function based on the
+// selected algorithm type. A randomized search gets its own generator, seeded
+// with the given seed.
+SearchFunction get_search_function(Algorithm algo, uint64_t seed = DEFAULT_SEED);
 
 #endif  // FORD_FULK_H
@@ -0,0 +1,52 @@
+#ifndef GOMORY_HU_HPP
+#define GOMORY_HU_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ford_fulk.hpp"
+
+// Header written in front of the arrays of a binary cut tree file
+struct CutTreeFileHeader {
+    char magic[8];     // "GHTREE"
+    uint32_t version;  // Format version
+    int32_t n;         // Number of vertices (followed by n parents and n weights)
+};
+
+// Counters reported while building a cut tree
+struct GomoryHuStats {
+    int threads = 1;       // Number of worker threads
+    long long flows = 0;   // Max-flow computations, including recomputed ones
+    long long misses = 0;  // Speculative cuts discarded because the tree moved
+};
+
+// Gomory-Hu cut tree: the minimum cut between any two vertices is the lightest
+// edge on their tree path. Vertex 0 is the root.
+struct GomoryHuTree {
+    std::vector<int32_t> parent;  // Tree parent of every vertex (-1 at the root)
+    std::vector<int32_t> weight;  // Minimum cut between a vertex and its parent
+    GomoryHuStats stats;
+
+    // Minimum cut value between u and v, walking both tree paths in O(n)
+    int min_cut(int u, int v) const;
+
+    // Writes the tree as a CutTreeFileHeader followed by the parent and weight
+    // arrays. Returns false on I/O failure.
+    bool dump(const std::string &path) const;
+
+    // Reads a tree written by dump(). Returns false if the file is missing or
+    // malformed.
+    bool load(const std::string &path);
+};
+
+// Builds the cut tree of the undirected view of the graph (an arc of capacity c
+// lets c units through in either direction) with Gusfield's algorithm: n - 1
+// max-flow solves on the unmodified graph, no contractions. Cuts are solved
+// speculatively in parallel, one residual copy per OpenMP thread, against the
+// tree as it stands, and committed in vertex order; a cut whose sink changed
+// by the time it is committed is solved again. Leaves the graph untouched. The
+// cut of vertex s is solved with seed + s.
+GomoryHuTree gomory_hu_tree(Graph &graph, Algorithm algo, uint64_t seed = DEFAULT_SEED);
+
+#endif  // GOMORY_HU_HPP
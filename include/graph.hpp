@@ -1,11 +1,15 @@
 #ifndef GRAPH_H
 #define GRAPH_H
 
+#include <cstdint>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <sstream>
 #include <vector>
 
+#include "arena.hpp"
+
 // Edge structure representing a directed edge with capacity, reverse index, and
 // critical edge count
 struct Edge {
@@ -17,8 +21,54 @@ struct Edge {
     Edge(int t, int cap, int rev) : to(t), capacity(cap), reverse_idx(rev) {}
 };
 
+// Outgoing edges of one vertex. Graphs read from DIMACS place every list in a
+// single arena slab; lists built edge by edge fall back to the heap.
+using EdgeList = std::vector<Edge, ArenaAllocator<Edge>>;
+
+// Global arc identifier: the position of an arc in the concatenation of every
+// adjacency list (the order used for the saved capacities). Half the size of an
+// Edge pointer and still valid if the adjacency storage is moved.
+using ArcId = uint32_t;
+
+// Marks the absence of an arc (e.g., the parent arc of the source)
+constexpr ArcId NO_ARC = std::numeric_limits<ArcId>::max();
+
+// Arc of a DIMACS "a" line, with 0-based endpoints
+struct ParsedArc {
+    unsigned tail, head, capacity;
+};
+
+// Contents of a DIMACS input as parsed by parse_dimacs
+struct DimacsInput {
+    unsigned num_vertices = 0;
+    unsigned num_arcs = 0;                         // Arcs stated by the "p max" line
+    std::vector<std::vector<ParsedArc>> buffers;  // Arcs parsed by each thread, in input order
+    size_t num_kept = 0;                          // Arcs kept, taken in buffer order
+    std::vector<int> sources;                     // Terminals listed anywhere in the input
+    std::vector<int> sinks;
+};
+
+// Reads a DIMACS input. The body is split at line boundaries and parsed by
+// every OpenMP thread at once; only the number of arcs stated by the header is
+// kept. Throws std::invalid_argument if the input lists no source or no sink.
+DimacsInput parse_dimacs(std::istream &in);
+
+// Passed as both source and sink to the augmenting path searches to solve the
+// multi-terminal problem of a graph (see Graph::has_terminal_sets)
+constexpr int ALL_TERMINALS = -1;
+
+// Source / sink of a graph that has not read any
+constexpr int NO_VERTEX = -2;
+
 enum class GraphInputFormat { Dimacs, Tournament };
 
+// Vertex numbering used by Graph::reorder_vertices
+enum class VertexOrder {
+    Input,               // As read from the input file
+    Bfs,                 // Breadth-first order from the source
+    ReverseCuthillMcKee  // Reverse Cuthill-McKee (bandwidth reducing)
+};
+
 // Graph class represents a directed graph using an adjacency list and supports
 // various graph operations
 class Graph
@@ -34,7 +84,8 @@ class Graph
     // Constructor to create a graph from another graph
     Graph(Graph *graph);
 
-    // Function to read a DIMACS-format graph from an input stream
+    // Function to read a DIMACS-format graph from an input stream. The body is
+    // split at line boundaries and parsed by every OpenMP thread at once.
     void read_dimacs(std::istream &in);
 
     // Retrieves the forward edge from a given vertex and edge index in the
@@ -46,17 +97,119 @@ class Graph
     Edge *get_reverse(Edge edge);
 
     // Retrieves the outgoing edges of a given vertex
-    std::vector<Edge> &get_outgoing_edges(int vertex);
+    EdgeList &get_outgoing_edges(int vertex);
+
+    // Retrieves the global id of the first arc leaving a vertex. Its other arcs
+    // follow in adjacency order.
+    ArcId get_first_arc(int vertex) const;
+
+    // Retrieves an arc by its global id
+    Edge &get_arc(ArcId arc);
+
+    // Retrieves the vertex an arc leaves from
+    int get_arc_tail(ArcId arc) const;
+
+    // Retrieves the residual capacity of an arc
+    int get_residual(ArcId arc) const;
+
+    // Retrieves the id of the arc in the opposite direction
+    ArcId get_reverse_arc(ArcId arc) const;
+
+    // Moves flow units along an arc: its residual capacity shrinks, the one of
+    // its reverse grows, and it is counted as critical if it saturates
+    void push_flow(ArcId arc, int flow);
+
+    // Calls visit(arc, head, residual capacity) for every arc leaving a vertex,
+    // in adjacency order, until it returns false
+    template <typename Visitor>
+    void visit_arcs(int vertex, Visitor &&visit) const
+    {
+        const EdgeList &edges = adjacency_list[vertex];
+        const ArcId first = first_arc[vertex];
+        for (size_t i = 0; i < edges.size(); ++i) {
+            if (!visit(first + i, edges[i].to, edges[i].capacity))
+                return;
+        }
+    }
 
     // A utility function to compute an upper bound for the flow that can be sent
     int compute_upper_flow_bound();
 
-    // Retrieves the source vertex of the graph
+    // Same bound between the given terminals (ALL_TERMINALS for the terminal
+    // sets): the smaller of the residual capacity leaving the source and the one
+    // entering the sink, i.e. the two cuts around the terminals
+    int compute_upper_flow_bound(int source, int sink);
+
+    // Stores the current capacities of every edge as the ones restored by
+    // reset_residual() and numbers the arcs. Called once the graph is built.
+    void save_capacities();
+
+    // Restores the saved capacities and clears the critical counters in a single
+    // pass over the edges, keeping every adjacency allocation in place. Much
+    // cheaper than copying the graph before each solve.
+    void reset_residual();
+
+    // Copies the residual capacity of every arc, in arc id order
+    void save_residual(std::vector<int> &residual) const;
+
+    // Sets the residual capacity of every arc from a save_residual() copy
+    void load_residual(const std::vector<int> &residual);
+
+    // FNV-1a hash of the vertex count, terminals, arc heads and saved
+    // capacities, telling apart the graphs a checkpoint may belong to
+    uint64_t get_fingerprint() const;
+
+    // Changes the saved capacity of the arc tail→head (the sum of its parallel
+    // input arcs). The arc must exist in either direction. Takes effect on the
+    // next reset_residual(); clears the unit bipartite flag until
+    // detect_unit_bipartite() runs again. Returns false if there is no such arc.
+    bool set_capacity(int tail, int head, int capacity);
+
+    // Turns every arc into an undirected edge: both arcs of an edge pair get the
+    // sum of their saved capacities, and the residual graph is reset to them
+    void make_undirected();
+
+    // Renumbers the vertices so that neighbors get nearby ids, moving each
+    // adjacency list to its new slot and remapping arc heads, saved capacities,
+    // source and sink. Both orders walk arcs in either direction; vertices left
+    // unreached start new sweeps. Returns the new id of every old vertex.
+    std::vector<int> reorder_vertices(VertexOrder order);
+
+    // Checks whether the graph is a unit-capacity bipartite matching instance:
+    // every positive arc has capacity 1 and goes source→left, left→right or
+    // right→sink, where left/right are the heads/tails of the source/sink arcs.
+    // Run by read_dimacs once the graph is loaded.
+    void detect_unit_bipartite();
+
+    // Whether the graph, as loaded, is a unit-capacity bipartite instance
+    bool is_unit_bipartite() const;
+
+    // Retrieves the arena holding the adjacency lists, or nullptr if they live
+    // on the heap (graphs built edge by edge)
+    const Arena *get_edge_arena() const;
+
+    // Retrieves the source vertex of the graph (the first one listed if there
+    // are several)
     int get_source() const;
 
-    // Retrieves the sink vertex of the graph
+    // Retrieves the sink vertex of the graph (the first one listed if there are
+    // several)
     int get_sink() const;
 
+    // Whether the input listed more than one source or sink ("n <id> s" and
+    // "n <id> t" lines). Such graphs are solved as if a super-source fed every
+    // source and every sink drained into a super-sink, without adding them.
+    bool has_terminal_sets() const;
+
+    // Retrieves every source / sink terminal listed in the input
+    const std::vector<int> &get_sources() const;
+    const std::vector<int> &get_sinks() const;
+
+    // Whether a vertex belongs to the source / sink terminal set. Only valid
+    // when has_terminal_sets() holds.
+    bool is_source_terminal(int vertex) const { return terminal_role[vertex] == SOURCE_ROLE; }
+    bool is_sink_terminal(int vertex) const { return terminal_role[vertex] == SINK_ROLE; }
+
     // Retrieves the total number of vertices in the graph
     int get_total_vertices() const;
 
@@ -64,18 +217,55 @@ class Graph
     int get_total_arcs() const;
 
    protected:
+    // Slab backing the adjacency lists. Destroying the graph releases every list
+    // with one deallocation instead of one per vertex.
+    std::shared_ptr<Arena> edge_arena;
+
     // Adjacency list to store the graph's edges: adjacency_list[vertex] contains
     // edges from that vertex
-    std::vector<std::vector<Edge>> adjacency_list;
+    std::vector<EdgeList> adjacency_list;
+
+    // Original capacities of every edge, stored contiguously in adjacency order
+    std::vector<int> original_capacities;
+
+    // Arc numbering: arcs of vertex v are first_arc[v] .. first_arc[v + 1] - 1
+    std::vector<ArcId> first_arc;
+    std::vector<int> arc_tails;  // Tail vertex of every arc
 
     // Number of vertices and edges (arcs) in the graph
     unsigned num_vertices_;
     unsigned num_arcs_;
 
+    // Set by detect_unit_bipartite()
+    bool unit_bipartite_ = false;
+
     // The source and sink vertices used in flow algorithms (such as
     // Ford-Fulkerson)
-    int source;
-    int sink;
+    int source = NO_VERTEX;
+    int sink = NO_VERTEX;
+
+    // Terminal sets of a multi-terminal input, with the role of every vertex
+    // (terminal_role is only filled when there is more than one source or sink)
+    enum TerminalRole : char { NO_ROLE, SOURCE_ROLE, SINK_ROLE };
+    std::vector<int> sources;
+    std::vector<int> sinks;
+    std::vector<char> terminal_role;
+
+    // Helper function to number the arcs once the adjacency lists are final
+    void build_arc_index();
+
+    // Helper function to fill terminal_role from the terminal sets
+    void build_terminal_roles();
+
+    // Helper function to create n empty adjacency lists in a fresh arena, each
+    // with room for the given number of edges so that add_edge never reallocates
+    void allocate_adjacency(const std::vector<size_t> &degrees);
+
+    // Helper function to build the adjacency lists from the arcs parsed by each
+    // thread, taken in buffer order up to num_kept arcs, exactly as adding them
+    // one by one with add_edge would: parallel and antiparallel arcs share an
+    // edge, and edges are listed in the order their first arc was read
+    void build_adjacency(const std::vector<std::vector<ParsedArc>> &buffers, size_t num_kept);
 
     // Helper function to resize the graph's adjacency list to accommodate a new
     // number of vertices
@@ -103,12 +293,87 @@ class TournamentGraph : public Graph
     // Retrieves if team one can win the tournament before computing maxflow
     bool team_one_can_win_before_flow() const;
 
-    // Retrieves if team one can win the tournament after computing maxflow
-    bool team_one_can_win_after_flow();
+    // Retrieves the number C of remaining games between teams 2..n: team 1 can
+    // win if and only if the max flow reaches it
+    int get_remaining_games() const;
 
    private:
     // Tournament specific field for checking if the team 1 can't win
     bool team_one_cant_win;
+
+    // Sum of the capacities leaving the source
+    int total_remaining_games = 0;
+};
+
+// Size of a graph before and after preprocessing
+struct ReductionStats {
+    int original_vertices = 0;    // Vertices of the input graph
+    int original_arcs = 0;        // Positive-capacity arcs of the input graph
+    int vertices = 0;             // Vertices kept
+    int arcs = 0;                 // Positive-capacity arcs kept
+    int pruned_vertices = 0;      // Unreachable from the source or unable to reach the sink
+    int contracted_vertices = 0;  // Inner vertices of contracted degree-2 chains
+
+    // Fraction of the input size (vertices plus arcs) left after preprocessing
+    double ratio() const
+    {
+        const int original = original_vertices + original_arcs;
+        return original > 0 ? static_cast<double>(vertices + arcs) / original : 1.0;
+    }
+};
+
+class ReducedGraph : public Graph
+{
+   public:
+    // Builds a compact copy of the original graph holding only what can carry
+    // flow:
+    // - vertices not reachable from the source, or that cannot reach the sink,
+    //   are dropped together with their arcs (as are arcs into the source and
+    //   out of the sink)
+    // - every vertex with a single arc in (from u) and a single arc out (to w)
+    //   is contracted into an arc u→w with the smaller capacity
+    // - remaining vertices are renumbered in their original order
+    // The original graph must not be modified until map_flow_back is done.
+    ReducedGraph(Graph &original);
+
+    // Retrieves the original id of a vertex of the reduced graph
+    int original_vertex(int vertex) const;
+
+    // Retrieves the reduced id of an original vertex, or -1 if it was removed
+    int reduced_vertex(int vertex) const;
+
+    // Writes the flow held in this graph's residual capacities onto the original
+    // graph's arcs (along every arc of a contracted chain), so cuts and residual
+    // checks can run on the original graph
+    void map_flow_back(Graph &original);
+
+    // Retrieves the sizes before and after preprocessing
+    const ReductionStats &get_reduction_stats() const;
+
+   private:
+    // Position of an original arc: adjacency_list[vertex][index]
+    struct ArcLocation {
+        int vertex;
+        int index;
+    };
+
+    // Arc of the reduced graph before parallel arcs are merged into one Edge
+    struct ReducedArc {
+        int capacity;
+        int chain_first;  // First original arc of the chain it replaces
+        int next;         // Next reduced arc merged into the same Edge (-1 ends)
+    };
+
+    std::vector<int> original_ids;  // Reduced vertex → original vertex
+    std::vector<int> reduced_ids;   // Original vertex → reduced vertex (-1 if removed)
+
+    std::vector<ArcLocation> original_arcs;  // Original arcs referenced by chains
+    std::vector<int> chain_next;             // Next original arc of the same chain (-1 ends)
+
+    std::vector<ReducedArc> reduced_arcs;
+    std::vector<std::vector<int>> edge_arcs;  // First reduced arc of each Edge, by adjacency
+
+    ReductionStats reduction;
 };
 
 #endif  // GRAPH_H
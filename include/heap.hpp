@@ -8,18 +8,18 @@
 #include <vector>
 
 // Struct representing a node in the heap, containing the vertex, its associated
-// capacity, and the incoming edge
+// capacity, and the incoming arc
 struct HeapNode {
-    int vertex;           // The vertex associated with this heap node
-    int capacity;         // The capacity (used as the key for the heap ordering)
-    Edge *incoming_edge;  // The incoming edge associated with the vertex
+    int vertex;          // The vertex associated with this heap node
+    int capacity;        // The capacity (used as the key for the heap ordering)
+    ArcId incoming_arc;  // The incoming arc associated with the vertex
 
     // Comparison operator to compare HeapNodes based on their capacity
     bool operator>(const HeapNode &other) const { return capacity > other.capacity; }
 };
 
 // Class implementing a k-ary heap data structure, where the heap stores
-// HeapNodes (vertex, capacity, incoming_edge) It provides operations such as
+// HeapNodes (vertex, capacity, incoming_arc) It provides operations such as
 // insert, delete max, and updates on the heap structure.
 class KHeap
 {
@@ -37,10 +37,10 @@ class KHeap
 
     // Updates the capacity of a given vertex, potentially changing its position
     // in the heap
-    void update(int vertex, int capacity, Edge *incoming_edge);
+    void update(int vertex, int capacity, ArcId incoming_arc);
 
-    // Inserts a new node (vertex, capacity, incoming_edge) into the heap
-    void insert(int vertex, int capacity, Edge *incoming_edge);
+    // Inserts a new node (vertex, capacity, incoming_arc) into the heap
+    void insert(int vertex, int capacity, ArcId incoming_arc);
 
     // Returns the current size (number of nodes) of the heap
     int get_size();
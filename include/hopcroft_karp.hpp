@@ -0,0 +1,14 @@
+#ifndef HOPCROFT_KARP_HPP
+#define HOPCROFT_KARP_HPP
+
+#include "ford_fulk.hpp"
+
+// Hopcroft-Karp maximum matching for unit-capacity bipartite graphs (see
+// Graph::is_unit_bipartite). Each phase finds a maximal set of shortest
+// vertex-disjoint augmenting paths, for O(m√n) overall. The matching is then
+// written back as flow (source→left→right→sink arcs saturated, critical
+// counters bumped) so the residual graph matches what Ford-Fulkerson leaves.
+// Expects the residual graph as loaded (or after reset_residual()).
+FordResult hopcroft_karp(Graph &graph, int source, int sink);
+
+#endif  // HOPCROFT_KARP_HPP
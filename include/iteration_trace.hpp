@@ -0,0 +1,69 @@
+#ifndef ITERATION_TRACE_HPP
+#define ITERATION_TRACE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "path_finding.hpp"
+
+// Fixed-size record describing one augmenting iteration. Kept as plain data so
+// a whole trace can be written to disk with a single write.
+struct IterationRecord {
+    int64_t timestamp_ns;   // Time since the start of the solve, in nanoseconds
+    int32_t visited_verts;  // n′_i: vertices visited by the path search
+    int32_t visited_arcs;   // m′_i: arcs visited by the path search
+    int32_t path_length;    // ℓ_i: length of the augmenting path
+    int32_t bottleneck;     // Flow pushed along the augmenting path
+    int32_t inserts;        // Heap insertions (Fattest Path only)
+    int32_t deletemaxes;    // Heap deletemaxes (Fattest Path only)
+    int32_t updates;        // Heap updates (Fattest Path only)
+    int32_t reserved;       // Padding, always zero
+};
+
+// Header written in front of the records of a binary trace file
+struct TraceFileHeader {
+    char magic[8];         // "FFTRACE"
+    uint32_t version;      // Format version
+    uint32_t record_size;  // sizeof(IterationRecord)
+    uint64_t num_records;  // Number of records following the header
+    int32_t n;             // Number of vertices of the traced graph
+    int32_t m;             // Number of arcs of the traced graph
+};
+
+// Append-only buffer of iteration records. Storage is reserved up front (an
+// augmentation pushes at least one unit of flow, so the flow upper bound caps
+// the number of iterations) so recording is a plain store in the common case.
+class IterationTrace
+{
+   public:
+    // Largest number of records reserved up front (40 MB of records)
+    static constexpr size_t MAX_RESERVED_RECORDS = 1 << 20;
+
+    // Reserves room for up to expected_iterations records and starts the clock
+    void begin(long long expected_iterations);
+
+    // Appends the record of an iteration that pushed bottleneck units of flow
+    void record(const PathStats &stats, int bottleneck)
+    {
+        auto now = std::chrono::steady_clock::now();
+        records.push_back(IterationRecord{
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count(),
+            stats.visited_verts, stats.visited_arcs, stats.path_length, bottleneck, stats.inserts,
+            stats.deletemaxes, stats.updates, 0});
+    }
+
+    // Retrieves the recorded iterations
+    const std::vector<IterationRecord> &get_records() const { return records; }
+
+    // Writes the trace to a binary file (TraceFileHeader followed by the
+    // records). Returns false if the file could not be written.
+    bool dump(const std::string &path, int n, int m) const;
+
+   private:
+    std::vector<IterationRecord> records;
+    std::chrono::steady_clock::time_point start;
+};
+
+#endif  // ITERATION_TRACE_HPP
@@ -9,9 +9,11 @@
 
 namespace Logger
 {
-void log_stats_header(const Algorithm &algo, std::ofstream &output_file);
+void log_stats_header(const Algorithm &algo, std::ofstream &output_file, bool with_perf = false,
+                      bool with_memory = false);
 void log_instance_stats(const GraphMetrics &metrics, const Algorithm &algo,
-                        std::ofstream &output_file);
+                        std::ofstream &output_file, bool with_perf = false,
+                        bool with_memory = false);
 }  // namespace Logger
 
 #endif  // LOGGER_H
@@ -0,0 +1,74 @@
+#ifndef MEMORY_COUNTERS_HPP
+#define MEMORY_COUNTERS_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+// Solver phases whose memory use is accounted. Parse covers reading (and
+// reordering or reducing) a graph, Copy preparing a fresh residual graph.
+enum class MemoryPhase { Parse, Copy, Solve, Metrics };
+
+// Quantities recorded for each phase
+enum class MemoryEvent { AllocatedBytes, Allocations, PeakRss };
+
+constexpr int NUM_MEMORY_PHASES = 4;
+constexpr int NUM_MEMORY_EVENTS = 3;
+
+// Accumulated memory counters, indexed by [phase][event]. Peak RSS is in KiB.
+struct MemoryStats {
+    std::array<std::array<double, NUM_MEMORY_EVENTS>, NUM_MEMORY_PHASES> values{};
+
+    // Function to incrementally accumulate counters
+    void increment(const MemoryStats &other);
+
+    // Function to average the counters by dividing by the number of runs
+    void average(int num_runs);
+
+    // Retrieves the accumulated value of an event during a phase
+    double get(MemoryPhase phase, MemoryEvent event) const;
+};
+
+// Counts every operator new made by any thread while an instance is alive
+// (the global allocation functions are replaced in memory_counters.cpp).
+// Between start() and stop() the bytes and allocations made are charged to
+// the given phase, together with the peak resident set size reached. The peak
+// is reset by start() through /proc/self/clear_refs; if the kernel refuses,
+// it is the peak of the whole process so far.
+class MemoryCounters
+{
+   public:
+    MemoryCounters();
+    ~MemoryCounters();
+
+    MemoryCounters(const MemoryCounters &) = delete;
+    MemoryCounters &operator=(const MemoryCounters &) = delete;
+
+    // Takes a snapshot of the counters marking the beginning of a phase
+    void start();
+
+    // Charges the allocations made since the last start() to the given phase
+    void stop(MemoryPhase phase);
+
+    // Clears all accumulated values
+    void reset();
+
+    // Retrieves the accumulated counters per phase
+    const MemoryStats &get_stats() const;
+
+   private:
+    uint64_t begin_bytes;        // Bytes allocated when start() was called
+    uint64_t begin_allocations;  // Allocations made when start() was called
+    MemoryStats stats;           // Accumulated values per phase
+};
+
+namespace Memory
+{
+// Retrieves the CSV column prefix of a phase (e.g., "solve")
+std::string phase_name(MemoryPhase phase);
+
+// Retrieves the CSV column suffix of an event (e.g., "alloc_bytes")
+std::string event_name(MemoryEvent event);
+}  // namespace Memory
+
+#endif  // MEMORY_COUNTERS_HPP
@@ -7,6 +7,7 @@
 #include <stdexcept>
 
 #include "ford_fulk.hpp"
+#include "memory_counters.hpp"
 
 // Structure that holds all the metrics related to the performance of the graph
 // and the algorithm.
@@ -25,6 +26,19 @@ struct GraphMetrics {
     double I;         // Average number of inserts (Fattest Path)
     double D;         // Average number of deletemaxes (Fattest Path)
     double U;         // Average number of updates (Fattest Path)
+    double threads;   // Worker threads (Parallel Push-Relabel)
+    double pushes;    // Number of pushes (Parallel Push-Relabel)
+    double relabels;  // Number of relabels (Parallel Push-Relabel, Pseudoflow)
+    double global_relabels;  // Number of global relabels (Parallel Push-Relabel)
+    double orphans;          // Number of orphans (Boykov-Kolmogorov)
+    double adoptions;        // Number of adopted orphans (Boykov-Kolmogorov)
+    double merges;           // Number of tree merges (Pseudoflow)
+    double splits;           // Number of tree splits (Pseudoflow)
+    double source_side;      // Fraction of vertices on the source side of the cut (Pseudoflow)
+    double speedup_ek;       // Serial Edmonds-Karp time / this time (Push-Relabel, BK)
+    double speedup_fp;       // Serial Fattest Path time / this time (Push-Relabel, BK)
+    PerfStats perf;   // Hardware counters per phase (only filled when enabled)
+    MemoryStats memory;  // Allocations and peak RSS per phase (only filled when enabled)
 
     // Function to incrementally accumulate metrics
     void increment(const GraphMetrics &other)
@@ -42,6 +56,19 @@ struct GraphMetrics {
         I += other.I;
         D += other.D;
         U += other.U;
+        threads += other.threads;
+        pushes += other.pushes;
+        relabels += other.relabels;
+        global_relabels += other.global_relabels;
+        orphans += other.orphans;
+        adoptions += other.adoptions;
+        merges += other.merges;
+        splits += other.splits;
+        source_side += other.source_side;
+        speedup_ek += other.speedup_ek;
+        speedup_fp += other.speedup_fp;
+        perf.increment(other.perf);
+        memory.increment(other.memory);
     }
 
     // Function to average the metrics by dividing by the number of runs
@@ -61,10 +88,33 @@ struct GraphMetrics {
             I /= num_runs;
             D /= num_runs;
             U /= num_runs;
+            threads /= num_runs;
+            pushes /= num_runs;
+            relabels /= num_runs;
+            global_relabels /= num_runs;
+            orphans /= num_runs;
+            adoptions /= num_runs;
+            merges /= num_runs;
+            splits /= num_runs;
+            source_side /= num_runs;
+            speedup_ek /= num_runs;
+            speedup_fp /= num_runs;
+            perf.average(num_runs);
+            memory.average(num_runs);
         }
     }
 };
 
+// Structure to hold the per-iteration averages extracted from an iteration trace
+struct TraceAverages {
+    double avg_l;  // Average path length
+    double avg_s;  // Average fraction of vertices visited (s_i = n′_i / n)
+    double avg_t;  // Average fraction of arcs visited (t_i = m′_i / m)
+    double I;      // Average normalized inserts (iᵢ = insertsᵢ / n)
+    double D;      // Average normalized deletemaxes (dᵢ = deletemaxesᵢ / n)
+    double U;      // Average normalized updates (uᵢ = updatesᵢ / m)
+};
+
 // Structure to hold the critical arc statistics of the graph
 struct CriticalArcStats {
     double C;      // Fraction of arcs that were critical at least once
@@ -78,10 +128,9 @@ namespace Metrics
 // given algorithm.
 long long compute_max_iterations(Graph &graph, int source, Algorithm algo, int upper_limit);
 
-// Function to compute the average value of elements in the range [0,1]
-// This is typically used for computing averages like average fraction of
-// visited vertices/arcs
-double compute_average(const std::vector<double> &elements, double total);
+// Function to compute the per-iteration averages of a trace in a single pass.
+// Every normalized value (s_i, t_i, iᵢ, dᵢ, uᵢ) is expected in the range [0,1]
+TraceAverages compute_trace_averages(const IterationTrace &trace, int n, int m);
 
 // Function to compute critical arc statistics, specific to the Edmonds-Karp
 // algorithm Returns the fraction of critical arcs and their average criticality
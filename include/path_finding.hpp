@@ -2,13 +2,15 @@
 #define PATHFINDING_HPP
 
 #include <algorithm>
+#include <array>
 #include <limits>
 #include <queue>
-#include <random>
 #include <stack>
 
+#include "compressed_graph.hpp"
 #include "graph.hpp"
 #include "heap.hpp"
+#include "xoshiro.hpp"
 
 // Structure to hold the statistics of a single augmenting path found during the
 // algorithm's execution. This includes information about the vertices, arcs,
@@ -39,24 +41,81 @@ struct PathStats {
 };
 
 // Structure to represent a flow path found in the graph. It stores the actual
-// path (as a stack of edges), the bottleneck capacity (the smallest capacity in
+// path (as a stack of arc ids), the bottleneck capacity (the smallest capacity in
 // the path), and the associated statistics for the path search.
 struct FlowPath {
-    std::stack<Edge *> path;  // Stack of edges representing the flow path
-    int bottleneck;           // The bottleneck capacity (minimum capacity in the path)
-    PathStats stats;          // Path statistics (e.g., number of visited vertices/arcs)
+    std::stack<ArcId> path;  // Stack of arcs representing the flow path
+    int bottleneck;          // The bottleneck capacity (minimum capacity in the path)
+    PathStats stats;         // Path statistics (e.g., number of visited vertices/arcs)
 };
 
+// Terminals of a plain s-t search
+struct SingleTerminals {
+    int source;
+    int sink;
+
+    std::array<int, 1> seeds() const { return {source}; }
+    bool is_source(int vertex) const { return vertex == source; }
+    bool is_sink(int vertex) const { return vertex == sink; }
+};
+
+// Terminal sets of a multi-terminal graph: the search starts from every source
+// at once and stops at the first sink reached, as if a super-source and a
+// super-sink were attached with unbounded arcs
+struct TerminalSets {
+    const Graph &graph;
+
+    const std::vector<int> &seeds() const { return graph.get_sources(); }
+    bool is_source(int vertex) const { return graph.is_source_terminal(vertex); }
+    bool is_sink(int vertex) const { return graph.is_sink_terminal(vertex); }
+};
+
+// Traces the path found by a search back from the sink it reached to a source,
+// following the parent arc of each vertex, and computes its bottleneck
+template <typename GraphType, typename Terminals, typename ParentArcs>
+FlowPath trace_path(const GraphType &graph, const Terminals &terminals,
+                    const ParentArcs &parent_arcs, int reached_sink, PathStats stats)
+{
+    int bottleneck = std::numeric_limits<int>::max();
+    std::stack<ArcId> path;
+
+    for (int current = reached_sink; !terminals.is_source(current);) {
+        ArcId arc = parent_arcs[current];
+        stats.path_length++;
+        path.push(arc);
+        bottleneck = std::min(bottleneck, graph.get_residual(arc));
+        current = graph.get_arc_tail(arc);
+    }
+
+    return FlowPath{path, bottleneck, stats};
+}
+
+// The searches below take the source and sink to connect, or ALL_TERMINALS as
+// both to connect the terminal sets of the graph.
+
 // Performs a breadth-first search (BFS) to find an augmenting path in the
 // graph.
 FlowPath bfs_path(Graph &graph, int source, int sink);
 
+// Performs a level-synchronous parallel BFS (OpenMP) to find a shortest
+// augmenting path. Large frontiers are expanded bottom-up, and parents are
+// claimed with atomic compare-and-swap, so the path found may differ from
+// bfs_path's but always has the same (shortest) length.
+FlowPath parallel_bfs_path(Graph &graph, int source, int sink);
+
 // Performs a randomized depth-first search (DFS) to find an augmenting path in
-// the graph.
-FlowPath randomized_dfs_path(Graph &graph, int source, int sink);
+// the graph. The arcs of each vertex are visited from a random offset with a
+// random stride coprime with its degree, drawn from rng, so no per-vertex
+// shuffle buffer is needed.
+FlowPath randomized_dfs_path(Graph &graph, int source, int sink, Xoshiro256 &rng);
 
 // Performs a modified Dijkstra's algorithm to find the fattest path in the
 // graph (path with the highest bottleneck).
 FlowPath modified_dijkstra_path(Graph &graph, int source, int sink);
 
+// Same searches as bfs_path and modified_dijkstra_path on a compressed graph,
+// decoding every neighbor list as it is scanned
+FlowPath compressed_bfs_path(CompressedGraph &graph, int source, int sink);
+FlowPath compressed_dijkstra_path(CompressedGraph &graph, int source, int sink);
+
 #endif
@@ -0,0 +1,81 @@
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+// Solver phases that can be instrumented with hardware counters. Copy covers
+// preparing a fresh residual graph before each run.
+enum class Phase { Load, Copy, Search, Augment, Metrics };
+
+// Hardware events recorded for each phase
+enum class PerfEvent { Cycles, Instructions, L1DMisses, LLCMisses, BranchMisses };
+
+constexpr int NUM_PHASES = 5;
+constexpr int NUM_PERF_EVENTS = 5;
+
+// Accumulated counter values, indexed by [phase][event]
+struct PerfStats {
+    std::array<std::array<double, NUM_PERF_EVENTS>, NUM_PHASES> values{};
+
+    // Function to incrementally accumulate counters
+    void increment(const PerfStats &other);
+
+    // Function to average the counters by dividing by the number of runs
+    void average(int num_runs);
+
+    // Retrieves the accumulated value of an event during a phase
+    double get(Phase phase, PerfEvent event) const;
+};
+
+// Thin wrapper over a perf_event_open counter group measuring, in user space,
+// the calling thread and every thread it creates after the counters are opened
+// (so the OpenMP workers of parallel phases are counted as long as their pool
+// starts afterwards). Counters are read between start() and stop() and the
+// difference is charged to the given phase. If the kernel refuses to open the
+// counters, every operation becomes a no-op and the stats remain zero.
+class PerfCounters
+{
+   public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    // Returns whether at least the cycle counter could be opened
+    bool is_available() const;
+
+    // Takes a snapshot of the counters marking the beginning of a phase
+    void start();
+
+    // Charges the counters elapsed since the last start() to the given phase
+    void stop(Phase phase);
+
+    // Clears all accumulated values
+    void reset();
+
+    // Retrieves the accumulated counters per phase
+    const PerfStats &get_stats() const;
+
+   private:
+    int leader_fd;                                // Group leader (cycles) file descriptor
+    std::array<int, NUM_PERF_EVENTS> fds;         // Per-event file descriptors (-1 if missing)
+    std::array<uint64_t, NUM_PERF_EVENTS> begin;  // Snapshot taken by start()
+    PerfStats stats;                              // Accumulated values per phase
+
+    // Helper function to read the current value of every event in the group
+    bool read_group(std::array<uint64_t, NUM_PERF_EVENTS> &out) const;
+};
+
+namespace Perf
+{
+// Retrieves the CSV column prefix of a phase (e.g., "search")
+std::string phase_name(Phase phase);
+
+// Retrieves the CSV column suffix of an event (e.g., "cycles")
+std::string event_name(PerfEvent event);
+}  // namespace Perf
+
+#endif  // PERF_COUNTERS_HPP
@@ -0,0 +1,19 @@
+#ifndef PSEUDOFLOW_HPP
+#define PSEUDOFLOW_HPP
+
+#include "ford_fulk.hpp"
+
+// Hochbaum's pseudoflow algorithm, highest-label variant (first phase only).
+// Every source and sink arc is saturated up front, leaving a forest of strong
+// (excess) and weak (deficit) trees. The strong root with the highest label is
+// merged into a weak tree through an arc to a vertex one label below, its
+// excess is pushed towards the new root and the tree is split at every arc that
+// saturates. Labels are raised when no merger arc is left and a label gap lifts
+// the trees above it to the source side.
+// On return the strong vertices are exactly the source side of a minimum cut,
+// stored in FordResult::source_side, and max_flow is that cut's capacity. The
+// residual graph holds the final pseudoflow (excess is not routed back to the
+// source), so code that needs a feasible flow should use another engine.
+FordResult pseudoflow(Graph &graph, int source, int sink);
+
+#endif  // PSEUDOFLOW_HPP
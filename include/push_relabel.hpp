@@ -0,0 +1,18 @@
+#ifndef PUSH_RELABEL_HPP
+#define PUSH_RELABEL_HPP
+
+#include "ford_fulk.hpp"
+
+// Multi-threaded push-relabel after Hong's algorithm:
+// - every vertex is discharged by at most one thread at a time, pushing to its
+//   lowest residual neighbor, with excess and residual capacities updated
+//   through atomic read-modify-write operations (no locks on the graph)
+// - active vertices live in per-thread queues guarded by a mutex each, and
+//   idle threads steal work from them
+// - heights are periodically recomputed by a parallel global relabel
+//   (reverse BFS from the sink, then from the source)
+// The residual graph ends in a valid maximum flow, so cuts and residual
+// checks work as with the augmenting path engines. Uses the OpenMP threads.
+FordResult parallel_push_relabel(Graph &graph, int source, int sink);
+
+#endif  // PUSH_RELABEL_HPP
@@ -0,0 +1,55 @@
+#ifndef XOSHIRO_HPP
+#define XOSHIRO_HPP
+
+#include <cstdint>
+
+// Seed used by the randomized solvers unless another one is given (--seed), so
+// that runs are reproducible by default
+constexpr uint64_t DEFAULT_SEED = 0x5eed;
+
+// xoshiro256** pseudo-random generator (Blackman and Vigna): 32 bytes of state
+// and a handful of shifts per number. Each solve owns its generator, so
+// parallel solves never share state.
+class Xoshiro256
+{
+   public:
+    // Expands the seed into the full state with splitmix64, as recommended by
+    // the authors, so nearby seeds give unrelated sequences
+    explicit Xoshiro256(uint64_t seed = DEFAULT_SEED)
+    {
+        for (uint64_t &word : state) {
+            seed += 0x9e3779b97f4a7c15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    // Returns the next 64 random bits
+    uint64_t next()
+    {
+        const uint64_t result = rotl(state[1] * 5, 7) * 9;
+        const uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    // Returns a number in [0, bound) by multiply-shift (bias at most bound / 2^32)
+    uint32_t below(uint32_t bound)
+    {
+        return static_cast<uint32_t>(((next() >> 32) * static_cast<uint64_t>(bound)) >> 32);
+    }
+
+   private:
+    uint64_t state[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+#endif  // XOSHIRO_HPP
@@ -7,9 +7,16 @@ GEN="${SCRIPT_DIR}/../bin/graph_generator"
 # Dataset argument (defaults to all)
 DATASET="${1:-all}"
 
+# Generator threads (defaults to all cores)
+THREADS="${THREADS:-0}"
+
 # Output directory
 TARGET_BASE="${SCRIPT_DIR}/../data/graphs"
 
+# Every instance is queued in a manifest and generated concurrently at the end
+MANIFEST="$(mktemp)"
+trap 'rm -f "${MANIFEST}"' EXIT
+
 generate_mesh() {
     local TARGET="${TARGET_BASE}/mesh"
     mkdir -p "${TARGET}"
@@ -34,7 +41,7 @@ generate_mesh() {
         read -r r c <<<"$entry"
         out="${TARGET}/test_${count}.graph"
         echo "  -> $out (r=$r, c=$c, C=$C)"
-        $GEN $graph_type $r $c $C "$out"
+        echo "$graph_type $r $c $C $out" >>"${MANIFEST}"
         ((count++))
     done
 }
@@ -63,7 +70,7 @@ generate_matching() {
         read -r n d <<<"$entry"
         out="${TARGET}/test_${count}.graph"
         echo "  -> $out (n=$n, d=$d, C=$C)"
-        $GEN $graph_type $n $d $C "$out"
+        echo "$graph_type $n $d $C $out" >>"${MANIFEST}"
         ((count++))
     done
 }
@@ -92,7 +99,30 @@ generate_random_mesh() {
         read -r r c <<<"$entry"
         out="${TARGET}/test_${count}.graph"
         echo "  -> $out (r=$r, c=$c, C=$C)"
-        $GEN $graph_type $r $c $C "$out"
+        echo "$graph_type $r $c $C $out" >>"${MANIFEST}"
+        ((count++))
+    done
+}
+
+generate_cheryian() {
+    local TARGET="${TARGET_BASE}/cheryian"
+    mkdir -p "${TARGET}"
+    echo "Generating cheryian"
+    local graph_type=11
+    local C=1000000
+    local count=1
+
+    local nmc_values=(
+        "4 4 2" "8 4 2" "8 8 4"
+        "16 8 4" "16 16 8" "32 16 8"
+        "32 32 16" "64 32 16" "64 64 32"
+    )
+
+    for entry in "${nmc_values[@]}"; do
+        read -r n m c <<<"$entry"
+        out="${TARGET}/test_${count}.graph"
+        echo "  -> $out (n=$n, m=$m, c=$c, C=$C)"
+        echo "$graph_type $n $m $c $C $out" >>"${MANIFEST}"
         ((count++))
     done
 }
@@ -102,6 +132,7 @@ all)
     generate_mesh
     generate_matching
     generate_random_mesh
+    generate_cheryian
     ;;
 mesh)
     generate_mesh
@@ -112,10 +143,15 @@ matching)
 random_mesh)
     generate_random_mesh
     ;;
+cheryian)
+    generate_cheryian
+    ;;
 *)
     echo "Unknown dataset: $DATASET"
     exit 1
     ;;
 esac
 
+$GEN -m "${MANIFEST}" "${THREADS}" || exit 1
+
 echo "✅ Done!"
@@ -24,4 +24,20 @@ for subdir in "$SCRIPT_DIR/../data/graphs/"*/; do
     # Run for Fattest Path (Algorithm ID 2)
     fattest_path_output="${SCRIPT_DIR}/../data/outputs/${subdir_name}_fattest_path.csv"
     $FLOW_SOLVER 2 "$subdir" "$fattest_path_output"
+
+    # Run for Parallel Edmonds-Karp (Algorithm ID 3)
+    parallel_edmonds_karp_output="${SCRIPT_DIR}/../data/outputs/${subdir_name}_parallel_edmonds_karp.csv"
+    $FLOW_SOLVER 3 "$subdir" "$parallel_edmonds_karp_output"
+
+    # Run for Parallel Push-Relabel (Algorithm ID 4)
+    parallel_push_relabel_output="${SCRIPT_DIR}/../data/outputs/${subdir_name}_parallel_push_relabel.csv"
+    $FLOW_SOLVER 4 "$subdir" "$parallel_push_relabel_output"
+
+    # Run for Boykov-Kolmogorov (Algorithm ID 5)
+    boykov_kolmogorov_output="${SCRIPT_DIR}/../data/outputs/${subdir_name}_boykov_kolmogorov.csv"
+    $FLOW_SOLVER 5 "$subdir" "$boykov_kolmogorov_output"
+
+    # Run for Pseudoflow (Algorithm ID 6)
+    pseudoflow_output="${SCRIPT_DIR}/../data/outputs/${subdir_name}_pseudoflow.csv"
+    $FLOW_SOLVER 6 "$subdir" "$pseudoflow_output"
 done
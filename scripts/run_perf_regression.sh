@@ -0,0 +1,123 @@
+#!/bin/bash
+export LC_NUMERIC=C
+
+# Get the script's directory
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" &>/dev/null && pwd)"
+FLOW_SOLVER="${SCRIPT_DIR}/../bin/flow_solver"
+
+MODE="$1"                                                     # either "record" or "check"
+BASELINE="${2:-${SCRIPT_DIR}/../data/perf_baseline.csv}"      # baseline file
+GRAPH_DIR="${GRAPH_DIR:-${SCRIPT_DIR}/../data/graphs}"        # corpus root
+RUNS="${RUNS:-7}"                                             # solves per graph and algorithm
+THRESHOLD="${THRESHOLD:-0.10}"                                # allowed slowdown (0.10 = 10%)
+
+# Fixed corpus: a small to large instance of each generated family
+CORPUS=(
+    mesh/test_3 mesh/test_9 mesh/test_15 mesh/test_21
+    matching/test_3 matching/test_9 matching/test_15 matching/test_21
+    random_mesh/test_3 random_mesh/test_9 random_mesh/test_15 random_mesh/test_21
+)
+ALGORITHMS=(0 1 2 3 4 5 6)
+
+# Color setup
+GREEN='\033[0;32m'
+RED='\033[0;31m'
+YELLOW='\033[0;33m'
+NC='\033[0m'
+
+if [[ "$MODE" != "record" && "$MODE" != "check" ]]; then
+    echo "Usage: $0 [record|check] [baseline_file]"
+    echo "  Environment: GRAPH_DIR (corpus root), RUNS (default 7), THRESHOLD (default 0.10)"
+    exit 1
+fi
+
+if [[ "$MODE" == "check" && ! -f "$BASELINE" ]]; then
+    echo "Baseline file not found: $BASELINE (run '$0 record' first)"
+    exit 1
+fi
+
+# Runs one graph RUNS times and prints "median_us p95_us iterations". Prints
+# nothing if any run fails, instead of summarizing the runs that succeeded.
+measure() {
+    local algo="$1" graph="$2" runs="" line
+    for ((run = 0; run < RUNS; run++)); do
+        line=$("$FLOW_SOLVER" "$algo" --timing <"$graph") || return 1
+        runs+="${line}"$'\n'
+    done
+
+    printf "%s" "$runs" | sort -n -k3 | awk -v expected="$RUNS" '
+        { times[NR] = $3; iters[NR] = $2 }
+        END {
+            if (NR != expected) exit 1
+            median = (NR % 2) ? times[(NR + 1) / 2] : (times[NR / 2] + times[NR / 2 + 1]) / 2
+            p95 = int(0.95 * NR); if (p95 < 0.95 * NR) p95++
+            # Iterations of the median run (only the multi-threaded push-relabel
+            # count varies between runs: the randomized DFS seed is fixed)
+            printf "%.1f %d %d\n", median, times[p95], iters[int((NR + 1) / 2)]
+        }'
+}
+
+if [[ "$MODE" == "record" ]]; then
+    mkdir -p "$(dirname "$BASELINE")"
+    echo "graph,algorithm,median_us,p95_us,iterations" >"$BASELINE"
+fi
+
+regressions=0
+total=0
+
+for entry in "${CORPUS[@]}"; do
+    graph="${GRAPH_DIR}/${entry}.graph"
+    if [[ ! -f "$graph" ]]; then
+        echo "Missing corpus graph $graph (run ./scripts/gen_datasets.sh)"
+        exit 1
+    fi
+
+    for algo in "${ALGORITHMS[@]}"; do
+        read -r median p95 iterations <<<"$(measure "$algo" "$graph")"
+        if [[ -z "$median" ]]; then
+            echo "Solver failed on $graph (algorithm $algo)"
+            exit 1
+        fi
+
+        if [[ "$MODE" == "record" ]]; then
+            echo "$entry,$algo,$median,$p95,$iterations" >>"$BASELINE"
+            printf "%-24s algo=%d median=%sµs p95=%sµs iterations=%s\n" "$entry" "$algo" \
+                "$median" "$p95" "$iterations"
+            continue
+        fi
+
+        ((total++))
+        baseline_line=$(grep "^${entry},${algo}," "$BASELINE")
+        if [[ -z "$baseline_line" ]]; then
+            printf "%-24s algo=%d ${YELLOW}NO BASELINE${NC}\n" "$entry" "$algo"
+            continue
+        fi
+        IFS=, read -r _ _ base_median base_p95 base_iterations <<<"$baseline_line"
+
+        ratio=$(awk -v a="$median" -v b="$base_median" 'BEGIN { printf "%.3f", (b > 0) ? a / b : 1 }')
+        slower=$(awk -v r="$ratio" -v t="$THRESHOLD" 'BEGIN { print (r > 1 + t) ? 1 : 0 }')
+
+        note=""
+        if [[ "$iterations" != "$base_iterations" ]]; then
+            note=" (iterations ${base_iterations} -> ${iterations})"
+        fi
+
+        if [[ "$slower" == "1" ]]; then
+            ((regressions++))
+            printf "%-24s algo=%d ${RED}SLOWER${NC} median %sµs vs %sµs (x%s), p95 %sµs vs %sµs%s\n" \
+                "$entry" "$algo" "$median" "$base_median" "$ratio" "$p95" "$base_p95" "$note"
+        else
+            printf "%-24s algo=%d ${GREEN}OK${NC} median %sµs vs %sµs (x%s)%s\n" \
+                "$entry" "$algo" "$median" "$base_median" "$ratio" "$note"
+        fi
+    done
+done
+
+if [[ "$MODE" == "record" ]]; then
+    echo -e "\nBaseline written to $BASELINE"
+    exit 0
+fi
+
+# Summary
+echo -e "\nResults: $((total - regressions))/$total within ${THRESHOLD} of baseline"
+[ $regressions -eq 0 ] && exit 0 || exit 1
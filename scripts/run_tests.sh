@@ -28,12 +28,33 @@ for graph in "${TEST_GRAPHS[@]}"; do
     results+=($($FLOW_SOLVER 0 <"$graph" 2>/dev/null))
     labels+=("solver:edmonds-karp")
 
+    results+=($($FLOW_SOLVER 0 --preprocess <"$graph" 2>/dev/null))
+    labels+=("solver:edmonds-karp-preprocess")
+
     results+=($($FLOW_SOLVER 1 <"$graph" 2>/dev/null))
     labels+=("solver:randomized-dfs")
 
     results+=($($FLOW_SOLVER 2 <"$graph" 2>/dev/null))
     labels+=("solver:fattest-path")
 
+    results+=($($FLOW_SOLVER 0 --compressed <"$graph" 2>/dev/null))
+    labels+=("solver:edmonds-karp-compressed")
+
+    results+=($($FLOW_SOLVER 2 --compressed <"$graph" 2>/dev/null))
+    labels+=("solver:fattest-path-compressed")
+
+    results+=($($FLOW_SOLVER 3 <"$graph" 2>/dev/null))
+    labels+=("solver:parallel-edmonds-karp")
+
+    results+=($($FLOW_SOLVER 4 <"$graph" 2>/dev/null))
+    labels+=("solver:parallel-push-relabel")
+
+    results+=($($FLOW_SOLVER 5 <"$graph" 2>/dev/null))
+    labels+=("solver:boykov-kolmogorov")
+
+    results+=($($FLOW_SOLVER 6 <"$graph" 2>/dev/null))
+    labels+=("solver:pseudoflow")
+
     results+=($($FLOW_BOOST <"$graph" 2>/dev/null))
     labels+=("boost")
 
@@ -59,6 +80,78 @@ for graph in "${TEST_GRAPHS[@]}"; do
     fi
 done
 
+# Multi-terminal input: algorithms 0-3 must find the flow of the same graph
+# behind explicit super-terminals, algorithms 4-6 must reject it
+MULTI_ARCS="a 1 3 6
+a 1 4 2
+a 2 4 5
+a 2 1 3
+a 3 5 4
+a 4 5 3
+a 4 6 4
+a 5 7 5
+a 6 8 3
+a 6 7 2
+a 7 6 1
+a 3 8 2"
+MULTI_GRAPH=$(printf 'p max 8 12\nn 1 s\nn 2 s\nn 7 t\nn 8 t\n%s\n' "$MULTI_ARCS")
+SUPER_GRAPH=$(printf 'p max 10 16\nn 9 s\nn 10 t\n%s\n%s\n' \
+    "a 9 1 1000000
+a 9 2 1000000
+a 7 10 1000000
+a 8 10 1000000" "$MULTI_ARCS")
+expected=$($FLOW_BOOST <<<"$SUPER_GRAPH" 2>/dev/null)
+
+for algo in 0 1 2 3 4 5 6; do
+    ((total_tests++))
+    echo -n "Testing multi-terminal graph with solver $algo... "
+    result=$($FLOW_SOLVER $algo <<<"$MULTI_GRAPH" 2>/dev/null)
+    status=$?
+
+    if ((algo <= 3)) && [ $status -eq 0 ] && [ "$result" = "$expected" ]; then
+        ((passed_tests++))
+        printf "${GREEN}PASS${NC} (%d)\n" "$result"
+    elif ((algo > 3)) && [ $status -ne 0 ]; then
+        ((passed_tests++))
+        printf "${GREEN}PASS${NC} (rejected)\n"
+    else
+        printf "${RED}FAIL${NC} (solver=%s exit=%d super-terminals=%s)\n" \
+            "$result" "$status" "$expected"
+    fi
+done
+
+# Gomory-Hu tree: min cut queries answered from the tree of the undirected view
+# of a small graph must match direct s-t flows on that view (every arc doubled
+# in both directions). Four threads exercise the speculative commits.
+TREE_GRAPH=$(printf 'p max 8 12\nn 1 s\nn 8 t\n%s\n' "$MULTI_ARCS")
+TREE_FILE=$(mktemp)
+trap 'rm -f "$TREE_FILE"' EXIT
+pairs=""
+expected=""
+for ((u = 1; u <= 8; u++)); do
+    for ((v = u + 1; v <= 8; v++)); do
+        pairs+="$u $v"$'\n'
+        expected+="$(awk -v s=$u -v t=$v '
+            /^p/ { print "p max", $3, 2 * $4; print "n", s, "s"; print "n", t, "t" }
+            /^a/ { print; print "a", $3, $2, $4 }' <<<"$TREE_GRAPH" | $FLOW_BOOST 2>/dev/null) "
+    done
+done
+
+for algo in 0 1 2 3 4 5 6; do
+    ((total_tests++))
+    echo -n "Testing Gomory-Hu tree with solver $algo... "
+    : >"$TREE_FILE"
+    OMP_NUM_THREADS=4 $FLOW_SOLVER $algo --gomory-hu="$TREE_FILE" <<<"$TREE_GRAPH" &>/dev/null
+    result=$($FLOW_SOLVER --cut-tree="$TREE_FILE" <<<"$pairs" 2>/dev/null | tr '\n' ' ')
+
+    if [ "$result" = "$expected" ]; then
+        ((passed_tests++))
+        printf "${GREEN}PASS${NC} (%d pairs)\n" "$(wc -w <<<"$result")"
+    else
+        printf "${RED}FAIL${NC} (tree=%s flows=%s)\n" "$result" "$expected"
+    fi
+done
+
 # Summary
 echo -e "\nResults: $passed_tests/$total_tests passed"
 [ $passed_tests -eq $total_tests ] && exit 0 || exit 1
@@ -0,0 +1,303 @@
+#include "boykov_kolmogorov.hpp"
+
+#include <deque>
+
+namespace
+{
+
+enum Tree : char { FREE = 0, SOURCE_TREE = 1, SINK_TREE = 2 };
+
+class BoykovKolmogorovEngine
+{
+   public:
+    BoykovKolmogorovEngine(Graph& graph, int source, int sink)
+        : graph(graph),
+          n(graph.get_total_vertices()),
+          source(source),
+          sink(sink),
+          tree(n, FREE),
+          parent(n, NO_ARC),
+          active(n, 0),
+          timestamp(n, 0),
+          dist(n, 0)
+    {
+    }
+
+    FordResult run(bool should_get_stats)
+    {
+        int max_flow = 0;
+        int iterations = 0;
+        IterationTrace trace;
+
+        int flow_upper_bound = graph.compute_upper_flow_bound(source, sink);
+        if (should_get_stats)
+            trace.begin(flow_upper_bound);
+
+        auto start = std::chrono::high_resolution_clock::now();
+
+        tree[source] = SOURCE_TREE;
+        tree[sink] = SINK_TREE;
+        activate(source);
+        activate(sink);
+
+        // Each record covers the growth that found its path: the trees kept
+        // from earlier searches are not counted again
+        ArcId meeting_arc;
+        while ((meeting_arc = grow()) != NO_ARC) {
+            FlowPath path = augment(meeting_arc);
+            adopt();
+
+            iterations++;
+            max_flow += path.bottleneck;
+            if (should_get_stats)
+                trace.record(path.stats, path.bottleneck);
+            search_stats = PathStats{};
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+        FordResult result{max_flow, flow_upper_bound, iterations, duration, trace};
+        result.boykov_kolmogorov = bk_stats;
+        return result;
+    }
+
+   private:
+    Graph& graph;
+    const int n;
+    const int source;
+    const int sink;
+
+    std::vector<char> tree;      // Tree each vertex belongs to
+    std::vector<ArcId> parent;   // Tree arc: parent→v (source tree) or v→parent (sink tree)
+    std::vector<char> active;    // Whether a vertex is in the active queue
+    std::vector<int> timestamp;  // Last adoption pass that validated the vertex's origin
+    std::vector<int> dist;       // Distance to the tree root when validated
+    int time = 0;                // Current adoption pass
+
+    std::deque<int> active_queue;  // Active vertices (growing the trees)
+    std::deque<int> orphans;       // Vertices whose tree arc was saturated
+
+    PathStats search_stats;             // Statistics of the current search
+    BoykovKolmogorovStats bk_stats;     // Orphans and adoptions over the whole solve
+
+    // Residual capacity of the arc from tail to edge.to, seen from the tree of
+    // tail: source trees grow along arcs, sink trees against them
+    int tree_capacity(char t, Edge& edge)
+    {
+        return (t == SOURCE_TREE) ? edge.capacity : graph.get_reverse(edge)->capacity;
+    }
+
+    // Id of the arc in the opposite direction of an edge
+    ArcId reverse_arc(const Edge& edge) const
+    {
+        return graph.get_first_arc(edge.to) + edge.reverse_idx;
+    }
+
+    // Parent of a vertex in its tree, following its tree arc
+    int parent_vertex(int v)
+    {
+        return (tree[v] == SOURCE_TREE) ? graph.get_arc_tail(parent[v])
+                                        : graph.get_arc(parent[v]).to;
+    }
+
+    void activate(int v)
+    {
+        if (!active[v]) {
+            active[v] = 1;
+            active_queue.push_back(v);
+        }
+    }
+
+    // Grows both trees from the active vertices. Returns the arc (source tree →
+    // sink tree) where they meet, or NO_ARC when no augmenting path is left.
+    ArcId grow()
+    {
+        while (!active_queue.empty()) {
+            int p = active_queue.front();
+            if (tree[p] == FREE) {
+                active[p] = 0;
+                active_queue.pop_front();
+                continue;
+            }
+            search_stats.visited_verts++;
+
+            EdgeList& edges = graph.get_outgoing_edges(p);
+            const ArcId first_arc = graph.get_first_arc(p);
+            for (size_t i = 0; i < edges.size(); ++i) {
+                Edge& edge = edges[i];
+                search_stats.visited_arcs++;
+                if (tree_capacity(tree[p], edge) <= 0)
+                    continue;
+
+                int q = edge.to;
+                if (tree[q] == FREE) {
+                    tree[q] = tree[p];
+                    parent[q] = (tree[p] == SOURCE_TREE) ? first_arc + i : reverse_arc(edge);
+                    timestamp[q] = timestamp[p];
+                    dist[q] = dist[p] + 1;
+                    activate(q);
+                } else if (tree[q] != tree[p]) {
+                    // p stays active: it may still have unexplored arcs
+                    return (tree[p] == SOURCE_TREE) ? first_arc + i : reverse_arc(edge);
+                }
+            }
+
+            active[p] = 0;
+            active_queue.pop_front();
+        }
+        return NO_ARC;
+    }
+
+    // Pushes the bottleneck along source → meeting arc → sink, turning the
+    // vertices below saturated tree arcs into orphans
+    FlowPath augment(ArcId meeting_arc)
+    {
+        std::stack<ArcId> path;
+        const int meeting_tail = graph.get_arc_tail(meeting_arc);
+        const int meeting_head = graph.get_arc(meeting_arc).to;
+        int bottleneck = graph.get_residual(meeting_arc);
+        int path_length = 1;
+
+        // Source side: walk from the tail of the meeting arc up to the source
+        for (int v = meeting_tail; v != source; v = parent_vertex(v)) {
+            bottleneck = std::min(bottleneck, graph.get_residual(parent[v]));
+            path_length++;
+        }
+
+        // Sink side: walk from the head of the meeting arc down to the sink
+        for (int v = meeting_head; v != sink; v = parent_vertex(v)) {
+            bottleneck = std::min(bottleneck, graph.get_residual(parent[v]));
+            path_length++;
+        }
+
+        push(meeting_arc, bottleneck);
+        for (int v = meeting_tail; v != source;) {
+            const int next = parent_vertex(v);
+            if (push(parent[v], bottleneck))
+                make_orphan(v);
+            v = next;
+        }
+        for (int v = meeting_head; v != sink;) {
+            const int next = parent_vertex(v);
+            if (push(parent[v], bottleneck))
+                make_orphan(v);
+            v = next;
+        }
+
+        search_stats.path_length = path_length;
+        return FlowPath{path, bottleneck, search_stats};
+    }
+
+    // Pushes flow along an arc, returning whether it became saturated
+    bool push(ArcId arc, int flow)
+    {
+        graph.push_flow(arc, flow);
+        return graph.get_residual(arc) == 0;
+    }
+
+    void make_orphan(int v)
+    {
+        parent[v] = NO_ARC;
+        orphans.push_back(v);
+        bk_stats.orphans++;
+    }
+
+    // Returns the distance from v to its tree root through valid parents, or -1
+    // if the walk ends at an orphan. Validated vertices are stamped with the
+    // current pass so later walks can stop early.
+    int origin_distance(int v)
+    {
+        int d = 0;
+        int u = v;
+        while (true) {
+            if (timestamp[u] == time) {
+                d += dist[u];
+                break;
+            }
+            if (u == source || u == sink) {
+                timestamp[u] = time;
+                dist[u] = 0;
+                break;
+            }
+            if (parent[u] == NO_ARC)
+                return -1;
+            u = parent_vertex(u);
+            d++;
+        }
+
+        // Stamp the path with its distances
+        for (int w = v, wd = d; timestamp[w] != time; --wd) {
+            timestamp[w] = time;
+            dist[w] = wd;
+            w = parent_vertex(w);
+        }
+        return d;
+    }
+
+    // Finds new parents for the orphans, freeing those that cannot be adopted
+    void adopt()
+    {
+        time++;
+        while (!orphans.empty()) {
+            int v = orphans.front();
+            orphans.pop_front();
+            char t = tree[v];
+
+            // Look for the closest valid parent in the same tree
+            EdgeList& edges = graph.get_outgoing_edges(v);
+            const ArcId first_arc = graph.get_first_arc(v);
+            ArcId best_parent = NO_ARC;
+            int best_dist = std::numeric_limits<int>::max();
+            for (size_t i = 0; i < edges.size(); ++i) {
+                Edge& edge = edges[i];
+                int q = edge.to;
+                if (tree[q] != t)
+                    continue;
+
+                // Arc q→v (source tree) or v→q (sink tree) must be residual
+                if (tree_capacity(t == SOURCE_TREE ? SINK_TREE : SOURCE_TREE, edge) <= 0)
+                    continue;
+
+                int d = origin_distance(q);
+                if (d >= 0 && d < best_dist) {
+                    best_dist = d;
+                    best_parent = (t == SOURCE_TREE) ? reverse_arc(edge) : first_arc + i;
+                }
+            }
+
+            if (best_parent != NO_ARC) {
+                parent[v] = best_parent;
+                timestamp[v] = time;
+                dist[v] = best_dist + 1;
+                bk_stats.adoptions++;
+                continue;
+            }
+
+            // No parent: v leaves the tree. Its children become orphans and its
+            // neighbors that could reach it become active again.
+            for (size_t i = 0; i < edges.size(); ++i) {
+                Edge& edge = edges[i];
+                int q = edge.to;
+                if (tree[q] != t)
+                    continue;
+
+                if (tree_capacity(t == SOURCE_TREE ? SINK_TREE : SOURCE_TREE, edge) > 0)
+                    activate(q);
+
+                ArcId child_arc = (t == SOURCE_TREE) ? first_arc + i : reverse_arc(edge);
+                if (parent[q] == child_arc)
+                    make_orphan(q);
+            }
+            tree[v] = FREE;
+        }
+    }
+};
+
+}  // namespace
+
+FordResult boykov_kolmogorov(Graph& graph, int source, int sink, bool should_get_stats)
+{
+    BoykovKolmogorovEngine engine(graph, source, sink);
+    return engine.run(should_get_stats);
+}
@@ -1,79 +1,222 @@
 #include "ford_fulk.hpp"
 
-FordResult ford_fulkerson(Graph& graph, int source, int sink, Algorithm algo, bool should_get_stats)
+#include <omp.h>
+
+#include <memory>
+
+#include "boykov_kolmogorov.hpp"
+#include "hopcroft_karp.hpp"
+#include "pseudoflow.hpp"
+#include "push_relabel.hpp"
+
+namespace
+{
+
+// Augmenting loop shared by both graph layouts: find_path(graph, source, sink)
+// searches the residual graph and graph.push_flow(arc, flow) augments along it.
+// A resumed solve starts from the flow and iterations of its checkpoint.
+template <typename GraphType, typename Search>
+FordResult augment_paths(GraphType& graph, int source, int sink, Search&& find_path,
+                         bool should_get_stats, PerfCounters* perf, int target,
+                         Checkpointer* checkpoint)
 {
-    int max_flow = 0;
-    int iterations = 0;
+    const SolveProgress resumed = checkpoint ? checkpoint->get_resumed() : SolveProgress{};
+    int max_flow = resumed.max_flow;
+    int iterations = resumed.iterations;
     bool exists_path = false;
-    IterationStats stats;
+    IterationTrace stats;
 
-    SearchFunction find_path = get_search_function(algo);
-    int flow_upper_bound = graph.compute_upper_flow_bound();
+    int flow_upper_bound = max_flow + graph.compute_upper_flow_bound(source, sink);
+    if (should_get_stats)
+        stats.begin(flow_upper_bound);
 
     auto start = std::chrono::high_resolution_clock::now();
-    do {
+    exists_path = target == NO_TARGET || flow_upper_bound >= target;
+    while (exists_path && max_flow < target) {
+        if (perf)
+            perf->start();
         FlowPath bfs_result = find_path(graph, source, sink);
         exists_path = !bfs_result.path.empty();
+        if (perf)
+            perf->stop(Phase::Search);
 
         if (exists_path) {
+            if (perf)
+                perf->start();
             iterations++;
             int flow = bfs_result.bottleneck;
             max_flow += flow;
 
             while (!bfs_result.path.empty()) {
-                Edge* path_edge = bfs_result.path.top();
+                graph.push_flow(bfs_result.path.top(), flow);
                 bfs_result.path.pop();
-
-                path_edge->capacity -= flow;
-                graph.get_reverse(*path_edge)->capacity += flow;
-
-                if (path_edge->capacity == 0) {
-                    path_edge->num_criticals++;
-                }
             }
+            if (perf)
+                perf->stop(Phase::Augment);
+            if (checkpoint)
+                checkpoint->tick(graph, SolveProgress{max_flow, iterations});
         }
         if (should_get_stats and exists_path)
-            store_iteration_stats(stats, bfs_result.stats, graph.get_total_vertices(),
-                                  graph.get_total_arcs());
-
-    } while (exists_path);
+            stats.record(bfs_result.stats, bfs_result.bottleneck);
+    }
     auto end = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
 
     return FordResult{max_flow, flow_upper_bound, iterations, duration, stats};
 }
 
-SearchFunction get_search_function(Algorithm algo)
+}  // namespace
+
+FordResult ford_fulkerson(Graph& graph, int source, int sink, Algorithm algo, bool should_get_stats,
+                          PerfCounters* perf, uint64_t seed, int target, Checkpointer* checkpoint)
+{
+    return augment_paths(graph, source, sink, get_search_function(algo, seed), should_get_stats,
+                         perf, target, checkpoint);
+}
+
+FordResult ford_fulkerson(CompressedGraph& graph, int source, int sink, Algorithm algo,
+                          bool should_get_stats, Checkpointer* checkpoint)
 {
     switch (algo) {
         case Algorithm::EdmondsKarp:
-            return bfs_path;
-        case Algorithm::RandomizedDFS:
-            return randomized_dfs_path;
+            return augment_paths(graph, source, sink, compressed_bfs_path, should_get_stats,
+                                 nullptr, NO_TARGET, checkpoint);
         case Algorithm::FattestPath:
-            return modified_dijkstra_path;
+            return augment_paths(graph, source, sink, compressed_dijkstra_path, should_get_stats,
+                                 nullptr, NO_TARGET, checkpoint);
         default:
-            throw std::invalid_argument("Unknown algorithm");
+            throw std::invalid_argument("Compressed graphs need Edmonds-Karp or Fattest Path");
     }
 }
 
-void store_iteration_stats(IterationStats& stats, const PathStats& path_stats, int n, int m)
+FordResult solve_max_flow(Graph& graph, int source, int sink, Algorithm algo,
+                          bool should_get_stats, PerfCounters* perf, uint64_t seed)
 {
-    if (path_stats.visited_verts != 0)
-        stats.s_per_iter.emplace_back(static_cast<double>(path_stats.visited_verts) / n);
+    if (source == ALL_TERMINALS && !supports_terminal_sets(algo))
+        throw std::invalid_argument("Terminal sets need an augmenting path algorithm");
 
-    if (path_stats.visited_arcs != 0)
-        stats.t_per_iter.emplace_back(static_cast<double>(path_stats.visited_arcs) / m);
+    switch (algo) {
+        case Algorithm::ParallelPushRelabel:
+            return parallel_push_relabel(graph, source, sink);
+        case Algorithm::BoykovKolmogorov:
+            return boykov_kolmogorov(graph, source, sink, should_get_stats);
+        case Algorithm::Pseudoflow:
+            return pseudoflow(graph, source, sink);
+        default:
+            break;
+    }
+
+    // Matching instances skip the one-unit-per-augmentation loop, unless the
+    // per-iteration statistics of the chosen algorithm were asked for
+    if (!should_get_stats && graph.is_unit_bipartite() && source == graph.get_source() &&
+        sink == graph.get_sink())
+        return hopcroft_karp(graph, source, sink);
 
-    if (path_stats.path_length != 0)
-        stats.path_lengths_per_iter.emplace_back(path_stats.path_length);
+    return ford_fulkerson(graph, source, sink, algo, should_get_stats, perf, seed);
+}
 
-    if (path_stats.inserts != 0)
-        stats.inserts_per_iter.emplace_back(static_cast<double>(path_stats.inserts) / n);
+FordResult solve_max_flow_until(Graph& graph, int source, int sink, Algorithm algo, int target,
+                                bool should_get_stats, uint64_t seed)
+{
+    if (!has_augmenting_loop(algo) || (!should_get_stats && graph.is_unit_bipartite())) {
+        // Engines without an augmenting loop to cut short run to completion
+        int ceiling = graph.compute_upper_flow_bound(source, sink);
+        if (ceiling < target)
+            return FordResult{0, ceiling, 0, 0, IterationTrace{}};
+        return solve_max_flow(graph, source, sink, algo, should_get_stats, nullptr, seed);
+    }
+    return ford_fulkerson(graph, source, sink, algo, should_get_stats, nullptr, seed, target);
+}
 
-    if (path_stats.deletemaxes != 0)
-        stats.deletemaxes_per_iter.emplace_back(static_cast<double>(path_stats.deletemaxes) / n);
+std::vector<FordResult> solve_max_flow_batch(Graph& graph,
+                                             const std::vector<std::pair<int, int>>& pairs,
+                                             Algorithm algo, uint64_t seed)
+{
+    std::vector<FordResult> results(pairs.size());
+    const int num_threads = std::max(1, std::min<int>(omp_get_max_threads(), pairs.size()));
+
+#pragma omp parallel num_threads(num_threads)
+    {
+        std::unique_ptr<Graph> copy;
+        Graph* residual = &graph;
+        if (omp_get_thread_num() != 0) {
+            copy = std::make_unique<Graph>(&graph);
+            residual = copy.get();
+        }
+        // The first thread may only start solving once every copy is taken
+#pragma omp barrier
+
+#pragma omp for schedule(dynamic, 1)
+        for (size_t i = 0; i < pairs.size(); ++i) {
+            residual->reset_residual();
+            results[i] = solve_max_flow(*residual, pairs[i].first, pairs[i].second, algo, false,
+                                        nullptr, seed + i);
+        }
+    }
+    return results;
+}
 
-    if (path_stats.updates != 0)
-        stats.updates_per_iter.emplace_back(static_cast<double>(path_stats.updates) / m);
-}
\ No newline at end of file
+std::vector<char> min_cut_source_side(Graph& graph, int source, const FordResult& result)
+{
+    if (!result.source_side.empty())
+        return result.source_side;
+
+    std::vector<char> reached(graph.get_total_vertices(), 0);
+    std::vector<int> stack = {source};
+    reached[source] = 1;
+    while (!stack.empty()) {
+        int v = stack.back();
+        stack.pop_back();
+        for (const Edge& edge : graph.get_outgoing_edges(v)) {
+            if (edge.capacity > 0 && !reached[edge.to]) {
+                reached[edge.to] = 1;
+                stack.push_back(edge.to);
+            }
+        }
+    }
+    return reached;
+}
+
+bool supports_terminal_sets(Algorithm algo)
+{
+    switch (algo) {
+        case Algorithm::EdmondsKarp:
+        case Algorithm::RandomizedDFS:
+        case Algorithm::FattestPath:
+        case Algorithm::ParallelEdmondsKarp:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool has_augmenting_loop(Algorithm algo)
+{
+    switch (algo) {
+        case Algorithm::EdmondsKarp:
+        case Algorithm::RandomizedDFS:
+        case Algorithm::FattestPath:
+        case Algorithm::ParallelEdmondsKarp:
+            return true;
+        default:
+            return false;
+    }
+}
+
+SearchFunction get_search_function(Algorithm algo, uint64_t seed)
+{
+    switch (algo) {
+        case Algorithm::EdmondsKarp:
+            return bfs_path;
+        case Algorithm::RandomizedDFS:
+            return [rng = Xoshiro256(seed)](Graph& graph, int source, int sink) mutable {
+                return randomized_dfs_path(graph, source, sink, rng);
+            };
+        case Algorithm::FattestPath:
+            return modified_dijkstra_path;
+        case Algorithm::ParallelEdmondsKarp:
+            return parallel_bfs_path;
+        default:
+            throw std::invalid_argument("Unknown algorithm");
+    }
+}
@@ -0,0 +1,188 @@
+#include "hopcroft_karp.hpp"
+
+#include <queue>
+
+namespace
+{
+
+constexpr int FREE = -1;
+constexpr int UNREACHED = std::numeric_limits<int>::max();
+
+class HopcroftKarpEngine
+{
+   public:
+    HopcroftKarpEngine(Graph& graph, int source, int sink)
+        : graph(graph), source(source), sink(sink), right_index(graph.get_total_vertices(), FREE)
+    {
+        build();
+    }
+
+    FordResult run()
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        int flow_upper_bound = graph.compute_upper_flow_bound(source, sink);
+
+        int matching = 0;
+        int phases = 0;
+        while (layer()) {
+            phases++;
+            for (int u = 0; u < num_left; ++u) {
+                if (match_left[u] == FREE && augment(u))
+                    matching++;
+            }
+        }
+        write_flow();
+
+        auto end = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+        return FordResult{matching, flow_upper_bound, phases, duration, IterationTrace{}};
+    }
+
+   private:
+    Graph& graph;
+    const int source;
+    const int sink;
+    int num_left = 0;
+    int num_right = 0;
+
+    std::vector<int> right_index;  // Vertex → right index (FREE if not a right vertex)
+
+    // Left side in CSR form: arcs of left u are arc_start[u] .. arc_start[u + 1]
+    std::vector<Edge*> source_arcs;  // source→left arc of each left vertex
+    std::vector<int> arc_start;
+    std::vector<Edge*> arcs;       // left→right arcs
+    std::vector<int> arc_right;    // Right index of each arc
+    std::vector<Edge*> sink_arcs;  // right→sink arc of each right vertex
+
+    std::vector<int> match_left;   // Arc index matched by each left vertex
+    std::vector<int> match_right;  // Left vertex matched to each right vertex
+    std::vector<int> dist;         // BFS layer of each left vertex
+    int free_dist = UNREACHED;     // Layer of the left vertices next to the closest free right one
+    std::vector<int> next_arc;     // DFS position of each left vertex
+
+    void build()
+    {
+        for (Edge& edge : graph.get_outgoing_edges(sink)) {
+            Edge* into_sink = graph.get_reverse(edge);
+            if (into_sink->capacity > 0) {
+                right_index[edge.to] = num_right++;
+                sink_arcs.push_back(into_sink);
+            }
+        }
+
+        arc_start.push_back(0);
+        for (Edge& to_left : graph.get_outgoing_edges(source)) {
+            if (to_left.capacity <= 0)
+                continue;
+            for (Edge& edge : graph.get_outgoing_edges(to_left.to)) {
+                if (edge.capacity > 0 && right_index[edge.to] != FREE) {
+                    arcs.push_back(&edge);
+                    arc_right.push_back(right_index[edge.to]);
+                }
+            }
+            source_arcs.push_back(&to_left);
+            arc_start.push_back(arcs.size());
+            num_left++;
+        }
+
+        match_left.assign(num_left, FREE);
+        match_right.assign(num_right, FREE);
+        dist.resize(num_left);
+        next_arc.resize(num_left);
+    }
+
+    // BFS from the free left vertices over alternating paths, stopping at the
+    // layer where the first free right vertex shows up (only shortest paths
+    // are augmented in a phase). Returns whether a free right vertex is
+    // reachable.
+    bool layer()
+    {
+        std::queue<int> queue;
+        for (int u = 0; u < num_left; ++u) {
+            dist[u] = (match_left[u] == FREE) ? 0 : UNREACHED;
+            if (dist[u] == 0)
+                queue.push(u);
+            next_arc[u] = arc_start[u];
+        }
+
+        free_dist = UNREACHED;
+        while (!queue.empty()) {
+            int u = queue.front();
+            queue.pop();
+            if (dist[u] > free_dist)
+                break;  // The rest of the queue is deeper still
+            for (int a = arc_start[u]; a < arc_start[u + 1]; ++a) {
+                int w = match_right[arc_right[a]];
+                if (w == FREE) {
+                    free_dist = dist[u];
+                } else if (dist[w] == UNREACHED) {
+                    dist[w] = dist[u] + 1;
+                    queue.push(w);
+                }
+            }
+        }
+        return free_dist != UNREACHED;
+    }
+
+    // Iterative DFS along the BFS layers from the free left vertex root,
+    // flipping the matching along the path found
+    bool augment(int root)
+    {
+        std::vector<int> stack = {root};
+        while (!stack.empty()) {
+            int u = stack.back();
+            if (next_arc[u] == arc_start[u + 1]) {
+                dist[u] = UNREACHED;  // Dead end for the rest of the phase
+                stack.pop_back();
+                continue;
+            }
+
+            int a = next_arc[u];
+            int w = match_right[arc_right[a]];
+            if (w == FREE && dist[u] == free_dist) {
+                // Each left vertex on the stack takes the right vertex its
+                // current arc points to
+                for (int v : stack) {
+                    match_left[v] = next_arc[v];
+                    match_right[arc_right[next_arc[v]]] = v;
+                }
+                return true;
+            }
+            if (w != FREE && dist[w] == dist[u] + 1 && dist[w] <= free_dist) {
+                stack.push_back(w);  // u keeps its arc until w is resolved
+            } else {
+                next_arc[u]++;
+            }
+        }
+        return false;
+    }
+
+    void saturate(Edge* edge)
+    {
+        edge->capacity--;
+        graph.get_reverse(*edge)->capacity++;
+        edge->num_criticals++;
+    }
+
+    // Pushes one unit along source→left→right→sink for every matched pair
+    void write_flow()
+    {
+        for (int u = 0; u < num_left; ++u) {
+            if (match_left[u] == FREE)
+                continue;
+            int a = match_left[u];
+            saturate(source_arcs[u]);
+            saturate(arcs[a]);
+            saturate(sink_arcs[arc_right[a]]);
+        }
+    }
+};
+
+}  // namespace
+
+FordResult hopcroft_karp(Graph& graph, int source, int sink)
+{
+    HopcroftKarpEngine engine(graph, source, sink);
+    return engine.run();
+}
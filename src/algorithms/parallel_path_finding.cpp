@@ -0,0 +1,142 @@
+#include <omp.h>
+
+#include <atomic>
+
+#include "path_finding.hpp"
+
+// Frontiers smaller than this are expanded by a single thread
+constexpr size_t PARALLEL_FRONTIER_THRESHOLD = 256;
+
+// Switch to bottom-up expansion once the frontier holds more than 1/DIVISOR of
+// the vertices
+constexpr int BOTTOM_UP_DIVISOR = 16;
+
+namespace
+{
+
+template <typename Terminals>
+FlowPath parallel_bfs_search(Graph& graph, const Terminals& terminals)
+{
+    const int num_verts = graph.get_total_vertices();
+
+    // Data structures initialization
+    std::vector<std::atomic<ArcId>> parent_arcs(num_verts);
+    for (auto& arc : parent_arcs) arc.store(NO_ARC, std::memory_order_relaxed);
+    std::vector<char> in_frontier(num_verts, 0);
+    const auto& seeds = terminals.seeds();
+    std::vector<int> frontier(seeds.begin(), seeds.end());
+    std::vector<int> next_frontier;
+    std::atomic<int> reached_sink(-1);
+    PathStats stats;
+
+    long long visited_verts = 0;
+    long long visited_arcs = 0;
+
+    // Run level-synchronous BFS until a sink is reached or the frontier empties
+    while (!frontier.empty() && reached_sink.load(std::memory_order_relaxed) < 0) {
+        visited_verts += frontier.size();
+        next_frontier.clear();
+
+        const bool parallel = frontier.size() >= PARALLEL_FRONTIER_THRESHOLD;
+        const bool bottom_up = frontier.size() > static_cast<size_t>(num_verts / BOTTOM_UP_DIVISOR);
+
+        if (!bottom_up) {
+            // Top-down: every frontier vertex claims its unvisited neighbors
+#pragma omp parallel if (parallel) reduction(+ : visited_arcs)
+            {
+                std::vector<int> local_next;
+
+#pragma omp for schedule(dynamic, 64) nowait
+                for (size_t i = 0; i < frontier.size(); ++i) {
+                    EdgeList& edges = graph.get_outgoing_edges(frontier[i]);
+                    const ArcId first_arc = graph.get_first_arc(frontier[i]);
+                    for (size_t j = 0; j < edges.size(); ++j) {
+                        int u = edges[j].to;
+                        visited_arcs++;
+
+                        if (terminals.is_source(u) || (edges[j].capacity <= 0) ||
+                            parent_arcs[u].load(std::memory_order_relaxed) != NO_ARC)
+                            continue;
+
+                        // Only one thread wins the right to set u's parent
+                        ArcId expected = NO_ARC;
+                        if (parent_arcs[u].compare_exchange_strong(expected, first_arc + j,
+                                                                   std::memory_order_relaxed)) {
+                            if (terminals.is_sink(u))
+                                reached_sink.store(u, std::memory_order_relaxed);
+                            else
+                                local_next.push_back(u);
+                        }
+                    }
+                }
+
+#pragma omp critical
+                next_frontier.insert(next_frontier.end(), local_next.begin(), local_next.end());
+            }
+        } else {
+            // Bottom-up: every unvisited vertex looks for a residual arc coming
+            // from the frontier. Arcs into v are the reverses of v's own arcs.
+            // Only the arcs examined from the frontier (into unvisited vertices)
+            // count as visited, not the probes of other neighbors, so each arc
+            // is counted at most once per search: a vertex is in the frontier
+            // of a single level.
+            for (int v : frontier) in_frontier[v] = 1;
+
+#pragma omp parallel if (parallel) reduction(+ : visited_arcs)
+            {
+                std::vector<int> local_next;
+
+#pragma omp for schedule(dynamic, 256) nowait
+                for (int v = 0; v < num_verts; ++v) {
+                    if (terminals.is_source(v) ||
+                        parent_arcs[v].load(std::memory_order_relaxed) != NO_ARC)
+                        continue;
+
+                    for (Edge& edge : graph.get_outgoing_edges(v)) {
+                        if (!in_frontier[edge.to])
+                            continue;
+                        visited_arcs++;
+
+                        ArcId incoming = graph.get_first_arc(edge.to) + edge.reverse_idx;
+                        if (graph.get_arc(incoming).capacity > 0) {
+                            // v is owned by this thread, no other writer exists
+                            parent_arcs[v].store(incoming, std::memory_order_relaxed);
+                            if (terminals.is_sink(v))
+                                reached_sink.store(v, std::memory_order_relaxed);
+                            else
+                                local_next.push_back(v);
+                            break;
+                        }
+                    }
+                }
+
+#pragma omp critical
+                next_frontier.insert(next_frontier.end(), local_next.begin(), local_next.end());
+            }
+
+            for (int v : frontier) in_frontier[v] = 0;
+        }
+
+        frontier.swap(next_frontier);
+    }
+
+    stats.visited_verts = static_cast<int>(visited_verts);
+    stats.visited_arcs = static_cast<int>(visited_arcs);
+
+    // Return empty stack and 0 if didn't find a path
+    if (reached_sink.load() < 0) {
+        return FlowPath{std::stack<ArcId>{}, 0, stats};
+    }
+
+    // Trace back from sink to source calculating bottleneck
+    return trace_path(graph, terminals, parent_arcs, reached_sink.load(), stats);
+}
+
+}  // namespace
+
+FlowPath parallel_bfs_path(Graph& graph, int source, int sink)
+{
+    if (source == ALL_TERMINALS)
+        return parallel_bfs_search(graph, TerminalSets{graph});
+    return parallel_bfs_search(graph, SingleTerminals{source, sink});
+}
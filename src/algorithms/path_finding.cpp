@@ -1,134 +1,135 @@
 #include "path_finding.hpp"
 
-FlowPath bfs_path(Graph& graph, int source, int sink)
+#include <numeric>
+
+namespace
+{
+
+// Random step through a list of the given degree that visits every position
+// once: any stride coprime with the degree does
+uint32_t random_stride(Xoshiro256& rng, uint32_t degree)
+{
+    if (degree <= 2)
+        return 1;
+    uint32_t stride = 1 + rng.below(degree - 1);
+    while (std::gcd(stride, degree) != 1) stride = stride % (degree - 1) + 1;
+    return stride;
+}
+
+template <typename GraphType, typename Terminals>
+FlowPath bfs_search(const GraphType& graph, const Terminals& terminals)
 {
     // Data structures initialization
-    std::vector<Edge*> parent_edges(graph.get_total_vertices(), nullptr);
+    std::vector<ArcId> parent_arcs(graph.get_total_vertices(), NO_ARC);
     std::queue<int> q;
     PathStats stats;
 
-    q.push(source);
-    bool found_path = false;
+    for (int source : terminals.seeds()) q.push(source);
+    int reached_sink = -1;
 
-    // Run BFS to attempt to find a path to sink node
-    while (!q.empty() && !found_path) {
+    // Run BFS to attempt to find a path to a sink node
+    while (!q.empty() && reached_sink < 0) {
         int v = q.front();
         q.pop();
         stats.visited_verts++;
 
-        for (Edge& edge : graph.get_outgoing_edges(v)) {
-            int u = edge.to;
+        graph.visit_arcs(v, [&](ArcId arc, int u, int capacity) {
             stats.visited_arcs++;
 
-            if ((u != source) && (!parent_edges[u]) && (edge.capacity > 0)) {
-                parent_edges[u] = &edge;
+            if (!terminals.is_source(u) && (parent_arcs[u] == NO_ARC) && (capacity > 0)) {
+                parent_arcs[u] = arc;
 
-                if (u == sink) {
-                    found_path = true;
-                    break;
+                if (terminals.is_sink(u)) {
+                    reached_sink = u;
+                    return false;
                 }
 
                 q.push(u);
             }
-        }
+            return true;
+        });
     }
 
     // Return empty stack and 0 if didn't find a path
-    if (!parent_edges[sink]) {
-        return FlowPath{std::stack<Edge*>{}, 0, stats};
+    if (reached_sink < 0) {
+        return FlowPath{std::stack<ArcId>{}, 0, stats};
     }
 
-    int bottleneck = std::numeric_limits<int>::max();
-    std::stack<Edge*> path;
-
     // Trace back from sink to source calculating bottleneck
-    for (int current = sink; current != source;) {
-        Edge* edge = parent_edges[current];
-        stats.path_length++;
-        path.push(edge);
-        bottleneck = std::min(bottleneck, edge->capacity);
-        current = graph.get_reverse(*edge)->to;
-    }
-
-    return FlowPath{path, bottleneck, stats};
+    return trace_path(graph, terminals, parent_arcs, reached_sink, stats);
 }
 
-FlowPath randomized_dfs_path(Graph& graph, int source, int sink)
+template <typename Terminals>
+FlowPath randomized_dfs_search(Graph& graph, const Terminals& terminals, Xoshiro256& rng)
 {
     // Data structures initialization
-    std::vector<Edge*> parent_edges(graph.get_total_vertices(), nullptr);
+    std::vector<ArcId> parent_arcs(graph.get_total_vertices(), NO_ARC);
     std::stack<int> q;
     PathStats stats;
 
-    q.push(source);
-    bool found_path = false;
-
-    // Random number generator
-    static std::random_device rd;
-    static std::mt19937 rng(rd());
+    for (int source : terminals.seeds()) q.push(source);
+    int reached_sink = -1;
 
-    // Run Randomized DFS to attempt to find a path to sink node
-    while (!q.empty() && !found_path) {
+    // Run Randomized DFS to attempt to find a path to a sink node
+    while (!q.empty() && reached_sink < 0) {
         int v = q.top();
         q.pop();
         stats.visited_verts++;
 
-        // Get neighbors and shuffle in-place (no copies)
-        auto& neighbors = graph.get_outgoing_edges(v);
-        std::vector<Edge*> neighbor_ptrs;
-        neighbor_ptrs.reserve(neighbors.size());
-        for (Edge& e : neighbors) {
-            neighbor_ptrs.push_back(&e);
-        }
-        std::shuffle(neighbor_ptrs.begin(), neighbor_ptrs.end(), rng);
-
-        for (Edge* edge : neighbor_ptrs) {
-            int u = edge->to;
+        // Visit the neighbors in a random rotation and stride (no allocation)
+        EdgeList& edges = graph.get_outgoing_edges(v);
+        const uint32_t degree = edges.size();
+        if (degree == 0)
+            continue;
+        const ArcId first_arc = graph.get_first_arc(v);
+        const uint32_t stride = random_stride(rng, degree);
+        uint32_t i = rng.below(degree);
+
+        for (uint32_t step = 0; step < degree; ++step) {
+            const Edge& edge = edges[i];
+            int u = edge.to;
             stats.visited_arcs++;
 
-            if ((u != source) && (!parent_edges[u]) && (edge->capacity > 0)) {
-                parent_edges[u] = edge;
+            if (!terminals.is_source(u) && (parent_arcs[u] == NO_ARC) && (edge.capacity > 0)) {
+                parent_arcs[u] = first_arc + i;
 
-                if (u == sink) {
-                    found_path = true;
+                if (terminals.is_sink(u)) {
+                    reached_sink = u;
                     break;
                 }
 
                 q.push(u);
             }
+
+            i += stride;
+            if (i >= degree)
+                i -= degree;
         }
     }
 
     // Return empty stack and 0 if didn't find a path
-    if (!parent_edges[sink]) {
-        return FlowPath{std::stack<Edge*>{}, 0, stats};
+    if (reached_sink < 0) {
+        return FlowPath{std::stack<ArcId>{}, 0, stats};
     }
 
-    int bottleneck = std::numeric_limits<int>::max();
-    std::stack<Edge*> path;
-
     // Trace back from sink to source calculating bottleneck
-    for (int current = sink; current != source;) {
-        Edge* edge = parent_edges[current];
-        stats.path_length++;
-        path.push(edge);
-        bottleneck = std::min(bottleneck, edge->capacity);
-        current = graph.get_reverse(*edge)->to;
-    }
-
-    return FlowPath{path, bottleneck, stats};
+    return trace_path(graph, terminals, parent_arcs, reached_sink, stats);
 }
 
-FlowPath modified_dijkstra_path(Graph& graph, int source, int sink)
+template <typename GraphType, typename Terminals>
+FlowPath modified_dijkstra_search(const GraphType& graph, const Terminals& terminals)
 {
     int num_verts = graph.get_total_vertices();
     PathStats stats;
 
-    // Initialize priority queue (8-Ary MaxHeap) and parent_edges vector
-    std::vector<Edge*> parent_edges(graph.get_total_vertices(), nullptr);
+    // Initialize priority queue (8-Ary MaxHeap) and parent_arcs vector
+    std::vector<ArcId> parent_arcs(graph.get_total_vertices(), NO_ARC);
     KHeap priority_queue(num_verts, 8);
-    priority_queue.insert(source, std::numeric_limits<int>::max(), nullptr);
-    stats.inserts++;
+    for (int source : terminals.seeds()) {
+        priority_queue.insert(source, std::numeric_limits<int>::max(), NO_ARC);
+        stats.inserts++;
+    }
+    int reached_sink = -1;
 
     // Run Customized Dijkstra to attempt to find fattest path
     while (priority_queue.get_size() > 0) {
@@ -137,46 +138,70 @@ FlowPath modified_dijkstra_path(Graph& graph, int source, int sink)
         stats.visited_verts++;
         stats.deletemaxes++;
 
-        parent_edges[v] = current.incoming_edge;
-        if (v == sink)
+        parent_arcs[v] = current.incoming_arc;
+        if (terminals.is_sink(v)) {
+            reached_sink = v;
             break;
+        }
 
         // Process each neighbor of the current vertex
-        for (Edge& edge : graph.get_outgoing_edges(v)) {
-            int u = edge.to;
+        graph.visit_arcs(v, [&](ArcId arc, int u, int capacity) {
             stats.visited_arcs++;
 
-            if ((u != source) && (!parent_edges[u]) && (edge.capacity > 0)) {
-                int new_bottleneck = std::min(current.capacity, edge.capacity);
+            if (!terminals.is_source(u) && (parent_arcs[u] == NO_ARC) && (capacity > 0)) {
+                int new_bottleneck = std::min(current.capacity, capacity);
                 int existing_bottleneck = priority_queue.get_vertex_cap(u);
 
                 if (existing_bottleneck == -1) {
-                    priority_queue.insert(u, new_bottleneck, &edge);
+                    priority_queue.insert(u, new_bottleneck, arc);
                     stats.inserts++;
                 } else if (existing_bottleneck < new_bottleneck) {
-                    priority_queue.update(u, new_bottleneck, &edge);
+                    priority_queue.update(u, new_bottleneck, arc);
                     stats.updates++;
                 }
             }
-        }
+            return true;
+        });
     }
 
     // Return empty stack and 0 if didn't find a path
-    if (!parent_edges[sink]) {
-        return FlowPath{std::stack<Edge*>{}, 0, stats};
+    if (reached_sink < 0) {
+        return FlowPath{std::stack<ArcId>{}, 0, stats};
     }
 
-    int bottleneck = std::numeric_limits<int>::max();
-    std::stack<Edge*> path;
-
     // Trace back from sink to source calculating bottleneck
-    for (int current = sink; current != source;) {
-        Edge* edge = parent_edges[current];
-        stats.path_length++;
-        path.push(edge);
-        bottleneck = std::min(bottleneck, edge->capacity);
-        current = graph.get_reverse(*edge)->to;
-    }
+    return trace_path(graph, terminals, parent_arcs, reached_sink, stats);
+}
+
+}  // namespace
+
+FlowPath bfs_path(Graph& graph, int source, int sink)
+{
+    if (source == ALL_TERMINALS)
+        return bfs_search(graph, TerminalSets{graph});
+    return bfs_search(graph, SingleTerminals{source, sink});
+}
 
-    return FlowPath{path, bottleneck, stats};
+FlowPath randomized_dfs_path(Graph& graph, int source, int sink, Xoshiro256& rng)
+{
+    if (source == ALL_TERMINALS)
+        return randomized_dfs_search(graph, TerminalSets{graph}, rng);
+    return randomized_dfs_search(graph, SingleTerminals{source, sink}, rng);
+}
+
+FlowPath modified_dijkstra_path(Graph& graph, int source, int sink)
+{
+    if (source == ALL_TERMINALS)
+        return modified_dijkstra_search(graph, TerminalSets{graph});
+    return modified_dijkstra_search(graph, SingleTerminals{source, sink});
+}
+
+FlowPath compressed_bfs_path(CompressedGraph& graph, int source, int sink)
+{
+    return bfs_search(graph, SingleTerminals{source, sink});
+}
+
+FlowPath compressed_dijkstra_path(CompressedGraph& graph, int source, int sink)
+{
+    return modified_dijkstra_search(graph, SingleTerminals{source, sink});
 }
@@ -0,0 +1,338 @@
+#include "pseudoflow.hpp"
+
+namespace
+{
+
+constexpr int NONE = -1;
+
+class PseudoflowEngine
+{
+   public:
+    PseudoflowEngine(Graph& graph, int source, int sink)
+        : graph(graph),
+          n(graph.get_total_vertices()),
+          source(source),
+          sink(sink),
+          lifted_label(n),
+          excess(n, 0),
+          label(n, 0),
+          label_count(n + 1, 0),
+          parent(n, NONE),
+          parent_arc(n, NO_ARC),
+          first_child(n, NONE),
+          next_sibling(n, NONE),
+          prev_sibling(n, NONE),
+          next_scan(n, NONE),
+          next_arc(n, 0),
+          strong_roots(n + 1)
+    {
+    }
+
+    FordResult run()
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        int flow_upper_bound = graph.compute_upper_flow_bound(source, sink);
+
+        long long source_capacity = initialize();
+        for (int root = highest_strong_root(); root != NONE; root = highest_strong_root())
+            process_root(root);
+
+        // Strong vertices were all lifted: they form the source side of the cut.
+        // Arcs leaving it are saturated and arcs entering it carry no flow, so
+        // the cut capacity is the source outflow minus the excess kept inside.
+        FordResult result{0, flow_upper_bound, 0, 0, IterationTrace{}};
+        result.source_side.assign(n, 0);
+        result.source_side[source] = 1;
+        long long cut_capacity = source_capacity;
+        for (int v = 0; v < n; ++v) {
+            if (v != source && v != sink && label[v] == lifted_label) {
+                result.source_side[v] = 1;
+                cut_capacity -= excess[v];
+            }
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+
+        result.max_flow = static_cast<int>(cut_capacity);
+        result.iterations =
+            static_cast<int>(std::min<long long>(stats.merges, std::numeric_limits<int>::max()));
+        result.duration_ms =
+            std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        result.pseudoflow = stats;
+        return result;
+    }
+
+   private:
+    Graph& graph;
+    const int n;
+    const int source;
+    const int sink;
+    const int lifted_label;  // Label of the vertices moved to the source side
+
+    std::vector<long long> excess;  // Excess (> 0) or deficit (< 0) held by tree roots
+    std::vector<int> label;         // Label of each vertex
+    std::vector<int> label_count;   // Number of vertices with each label
+
+    // Forest of normalized trees, children kept in doubly linked sibling lists
+    std::vector<int> parent;
+    std::vector<ArcId> parent_arc;  // Arc from a vertex to its parent
+    std::vector<int> first_child;
+    std::vector<int> next_sibling;
+    std::vector<int> prev_sibling;
+
+    std::vector<int> next_scan;    // Next child to visit while processing a root
+    std::vector<size_t> next_arc;  // Next arc to scan for a merger since the last relabel
+
+    std::vector<std::vector<int>> strong_roots;  // Strong roots bucketed by label
+    int highest_label = 1;                        // Highest label that may hold a strong root
+
+    PseudoflowStats stats;
+
+    void move_flow(ArcId arc, int amount, int from, int to)
+    {
+        graph.push_flow(arc, amount);
+        excess[from] -= amount;
+        excess[to] += amount;
+    }
+
+    // Saturates every source and sink arc and buckets the vertices left with
+    // excess. Returns the capacity that left the source.
+    long long initialize()
+    {
+        long long source_capacity = 0;
+        const ArcId source_arcs = graph.get_first_arc(source);
+        const EdgeList& source_edges = graph.get_outgoing_edges(source);
+        for (size_t i = 0; i < source_edges.size(); ++i) {
+            const int to = source_edges[i].to;
+            const int capacity = source_edges[i].capacity;
+            if (to == source || capacity <= 0)
+                continue;
+            source_capacity += capacity;
+            move_flow(source_arcs + i, capacity, source, to);
+        }
+        const ArcId sink_arcs = graph.get_first_arc(sink);
+        const EdgeList& sink_edges = graph.get_outgoing_edges(sink);
+        for (size_t i = 0; i < sink_edges.size(); ++i) {
+            const int from = sink_edges[i].to;
+            const ArcId into_sink = graph.get_reverse_arc(sink_arcs + i);
+            const int capacity = graph.get_residual(into_sink);
+            if (from == sink || from == source || capacity <= 0)
+                continue;
+            move_flow(into_sink, capacity, from, sink);
+        }
+
+        for (int v = 0; v < n; ++v) {
+            if (v == source || v == sink)
+                continue;
+            if (excess[v] > 0) {
+                label[v] = 1;
+                strong_roots[1].push_back(v);
+            }
+            label_count[label[v]]++;
+        }
+        return source_capacity;
+    }
+
+    void add_child(int p, int child)
+    {
+        parent[child] = p;
+        prev_sibling[child] = NONE;
+        next_sibling[child] = first_child[p];
+        if (first_child[p] != NONE)
+            prev_sibling[first_child[p]] = child;
+        first_child[p] = child;
+    }
+
+    void remove_child(int p, int child)
+    {
+        if (prev_sibling[child] != NONE)
+            next_sibling[prev_sibling[child]] = next_sibling[child];
+        else
+            first_child[p] = next_sibling[child];
+        if (next_sibling[child] != NONE)
+            prev_sibling[next_sibling[child]] = prev_sibling[child];
+        parent[child] = NONE;
+        next_sibling[child] = prev_sibling[child] = NONE;
+    }
+
+    void set_label(int v, int new_label)
+    {
+        label_count[label[v]]--;
+        label[v] = new_label;
+        label_count[new_label]++;
+    }
+
+    // Pops the strong root with the highest label. Strong roots with no vertex
+    // one label below them cannot reach a deficit: their trees are lifted.
+    int highest_strong_root()
+    {
+        while (true) {
+            for (int l = highest_label; l > 0; --l) {
+                std::vector<int>& bucket = strong_roots[l];
+                if (bucket.empty())
+                    continue;
+
+                highest_label = l;
+                if (label_count[l - 1] > 0) {
+                    int root = bucket.back();
+                    bucket.pop_back();
+                    return root;
+                }
+                while (!bucket.empty()) {
+                    int root = bucket.back();
+                    bucket.pop_back();
+                    lift_tree(root);
+                }
+            }
+
+            // Roots split off label 0 vertices move up to label 1
+            if (strong_roots[0].empty())
+                return NONE;
+            for (int root : strong_roots[0]) {
+                set_label(root, 1);
+                strong_roots[1].push_back(root);
+            }
+            strong_roots[0].clear();
+            highest_label = 1;
+        }
+    }
+
+    // Moves every vertex of root's tree to the source side
+    void lift_tree(int root)
+    {
+        std::vector<int> stack = {root};
+        while (!stack.empty()) {
+            int v = stack.back();
+            stack.pop_back();
+            set_label(v, lifted_label);
+            for (int child = first_child[v]; child != NONE; child = next_sibling[child])
+                stack.push_back(child);
+        }
+    }
+
+    // Looks for a residual arc from v to a vertex one label below the strong
+    // root being processed. Returns NO_ARC if there is none.
+    ArcId find_merger(int v)
+    {
+        const EdgeList& edges = graph.get_outgoing_edges(v);
+        for (size_t i = next_arc[v]; i < edges.size(); ++i) {
+            const Edge& edge = edges[i];
+            if (edge.to == source || edge.to == sink || edge.capacity <= 0)
+                continue;
+            if (label[edge.to] == highest_label - 1) {
+                next_arc[v] = i;
+                return graph.get_first_arc(v) + i;
+            }
+        }
+        next_arc[v] = edges.size();
+        return NO_ARC;
+    }
+
+    // Advances v's scan to its next child on the same label. Once none is left,
+    // v has no merger arc in its subtree and is relabeled.
+    void check_children(int v)
+    {
+        for (; next_scan[v] != NONE; next_scan[v] = next_sibling[next_scan[v]]) {
+            if (label[next_scan[v]] == label[v])
+                return;
+        }
+        set_label(v, label[v] + 1);
+        next_arc[v] = 0;
+        stats.relabels++;
+    }
+
+    // Depth-first scan of the root's tree over vertices on the root's label,
+    // merging at the first arc found into a lower tree
+    void process_root(int root)
+    {
+        int v = root;
+        next_scan[root] = first_child[root];
+        if (ArcId arc = find_merger(root); arc != NO_ARC) {
+            merge(root, arc);
+            push_excess(root);
+            return;
+        }
+        check_children(root);
+
+        while (v != NONE) {
+            while (next_scan[v] != NONE) {
+                int child = next_scan[v];
+                next_scan[v] = next_sibling[child];
+                v = child;
+                next_scan[v] = first_child[v];
+
+                if (ArcId arc = find_merger(v); arc != NO_ARC) {
+                    merge(v, arc);
+                    push_excess(root);
+                    return;
+                }
+                check_children(v);
+            }
+            v = parent[v];
+            if (v != NONE)
+                check_children(v);
+        }
+
+        // No merger anywhere: the root was relabeled and waits for its turn
+        strong_roots[label[root]].push_back(root);
+        highest_label++;
+    }
+
+    // Reroots v's tree at v and hangs it below the head of the merger arc
+    void merge(int v, ArcId merger)
+    {
+        stats.merges++;
+        int current = v;
+        int new_parent = graph.get_arc(merger).to;
+        ArcId new_arc = merger;
+        while (parent[current] != NONE) {
+            int old_parent = parent[current];
+            ArcId old_arc = parent_arc[current];
+            remove_child(old_parent, current);
+            add_child(new_parent, current);
+            parent_arc[current] = new_arc;
+
+            new_parent = current;
+            new_arc = graph.get_reverse_arc(old_arc);
+            current = old_parent;
+        }
+        add_child(new_parent, current);
+        parent_arc[current] = new_arc;
+    }
+
+    // Pushes the old root's excess up to the new root, splitting off the
+    // subtree below every arc that saturates as a new strong root
+    void push_excess(int old_root)
+    {
+        long long parent_excess = 1;
+        int v = old_root;
+        while (excess[v] > 0 && parent[v] != NONE) {
+            int p = parent[v];
+            ArcId arc = parent_arc[v];
+            int residual = graph.get_residual(arc);
+            parent_excess = excess[p];
+
+            if (residual >= excess[v]) {
+                move_flow(arc, static_cast<int>(excess[v]), v, p);
+            } else {
+                move_flow(arc, residual, v, p);
+                remove_child(p, v);
+                strong_roots[label[v]].push_back(v);
+                stats.splits++;
+            }
+            v = p;
+        }
+
+        // A weak root that received more than its deficit becomes strong
+        if (excess[v] > 0 && parent_excess <= 0)
+            strong_roots[label[v]].push_back(v);
+    }
+};
+
+}  // namespace
+
+FordResult pseudoflow(Graph& graph, int source, int sink)
+{
+    PseudoflowEngine engine(graph, source, sink);
+    return engine.run();
+}
@@ -0,0 +1,298 @@
+#include "push_relabel.hpp"
+
+#include <omp.h>
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+
+constexpr int NO_HEIGHT = std::numeric_limits<int>::max();
+
+// Residual capacities are shared between threads: every access during the
+// solve goes through these atomic helpers
+int load_capacity(const Edge& edge) { return __atomic_load_n(&edge.capacity, __ATOMIC_RELAXED); }
+
+void add_capacity(Edge& edge, int delta)
+{
+    __atomic_fetch_add(&edge.capacity, delta, __ATOMIC_RELAXED);
+}
+
+// Active vertex queue owned by one thread, guarded by its mutex. The owner pops
+// from the back, idle threads steal from the front.
+struct alignas(64) WorkQueue {
+    std::mutex lock;
+    std::deque<int> items;
+};
+
+class PushRelabelEngine
+{
+   public:
+    PushRelabelEngine(Graph& graph, int source, int sink)
+        : graph(graph),
+          n(graph.get_total_vertices()),
+          source(source),
+          sink(sink),
+          num_threads(omp_get_max_threads()),
+          excess(n),
+          height(n),
+          queued(n),
+          queues(num_threads)
+    {
+    }
+
+    FordResult run()
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        int flow_upper_bound = graph.compute_upper_flow_bound(source, sink);
+
+        // Saturate every arc leaving the source
+        for (Edge& edge : graph.get_outgoing_edges(source)) {
+            int delta = edge.capacity;
+            if (delta <= 0 || edge.to == source)
+                continue;
+            edge.capacity = 0;
+            graph.get_reverse(edge)->capacity += delta;
+            excess[edge.to] += delta;
+            excess[source] -= delta;
+        }
+
+        stats.threads = num_threads;
+        while (true) {
+            global_relabel();
+            if (seed_active_vertices() == 0)
+                break;
+
+            stop.store(false);
+            relabels_since_global.store(0);
+
+#pragma omp parallel num_threads(num_threads)
+            worker(omp_get_thread_num());
+
+            // Leftover vertices are seeded again after the next global relabel
+            for (WorkQueue& queue : queues) queue.items.clear();
+            for (auto& flag : queued) flag.store(0, std::memory_order_relaxed);
+            num_active.store(0);
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+        int max_flow = static_cast<int>(excess[sink].load());
+        int iterations = static_cast<int>(
+            std::min<long long>(stats.pushes, std::numeric_limits<int>::max()));
+        return FordResult{max_flow, flow_upper_bound, iterations, duration, IterationTrace{}, stats};
+    }
+
+   private:
+    Graph& graph;
+    const int n;
+    const int source;
+    const int sink;
+    const int num_threads;
+
+    std::vector<std::atomic<long long>> excess;  // Excess flow of each vertex
+    std::vector<std::atomic<int>> height;        // Height (distance label) of each vertex
+    std::vector<std::atomic<char>> queued;       // Whether a vertex is queued or being discharged
+    std::vector<WorkQueue> queues;               // Per-thread active vertex queues
+
+    std::atomic<long long> num_active{0};            // Queued plus in-progress vertices
+    std::atomic<long long> relabels_since_global{0};  // Relabels since the last global relabel
+    std::atomic<bool> stop{false};                    // Requests a global relabel
+
+    PushRelabelStats stats;
+
+    // Recomputes exact heights: distance to the sink in the residual graph, or
+    // n plus the distance to the source for vertices that cannot reach the sink
+    void global_relabel()
+    {
+#pragma omp parallel for num_threads(num_threads)
+        for (int v = 0; v < n; ++v) height[v].store(NO_HEIGHT, std::memory_order_relaxed);
+
+        height[sink].store(0);
+        height[source].store(n);
+        reverse_bfs(sink, 0);
+        reverse_bfs(source, n);
+
+#pragma omp parallel for num_threads(num_threads)
+        for (int v = 0; v < n; ++v) {
+            if (height[v].load(std::memory_order_relaxed) == NO_HEIGHT)
+                height[v].store(2 * n, std::memory_order_relaxed);
+        }
+        stats.global_relabels++;
+    }
+
+    // Level-synchronous parallel BFS over residual arcs entering the frontier
+    void reverse_bfs(int root, int base)
+    {
+        std::vector<int> frontier = {root};
+        std::vector<int> next_frontier;
+
+        for (int level = base + 1; !frontier.empty(); ++level) {
+            next_frontier.clear();
+
+#pragma omp parallel num_threads(num_threads) if (frontier.size() >= 256)
+            {
+                std::vector<int> local_next;
+
+#pragma omp for schedule(dynamic, 64) nowait
+                for (size_t i = 0; i < frontier.size(); ++i) {
+                    for (Edge& edge : graph.get_outgoing_edges(frontier[i])) {
+                        int v = edge.to;
+                        if (v == source || v == sink || load_capacity(*graph.get_reverse(edge)) <= 0)
+                            continue;
+
+                        int expected = NO_HEIGHT;
+                        if (height[v].compare_exchange_strong(expected, level))
+                            local_next.push_back(v);
+                    }
+                }
+
+#pragma omp critical
+                next_frontier.insert(next_frontier.end(), local_next.begin(), local_next.end());
+            }
+
+            frontier.swap(next_frontier);
+        }
+    }
+
+    // Distributes every vertex with excess over the thread queues
+    long long seed_active_vertices()
+    {
+        for (int v = 0; v < n; ++v) {
+            if (v == source || v == sink || excess[v].load() <= 0 || height[v].load() >= 2 * n)
+                continue;
+            queued[v].store(1);
+            queues[v % num_threads].items.push_back(v);
+            num_active++;
+        }
+        return num_active.load();
+    }
+
+    // Queues v on the calling thread unless it is already queued
+    void activate(int v, int tid)
+    {
+        char expected = 0;
+        if (queued[v].load(std::memory_order_relaxed) ||
+            !queued[v].compare_exchange_strong(expected, 1))
+            return;
+
+        num_active++;
+        std::lock_guard<std::mutex> guard(queues[tid].lock);
+        queues[tid].items.push_back(v);
+    }
+
+    bool pop_own(int tid, int& v)
+    {
+        std::lock_guard<std::mutex> guard(queues[tid].lock);
+        if (queues[tid].items.empty())
+            return false;
+        v = queues[tid].items.back();
+        queues[tid].items.pop_back();
+        return true;
+    }
+
+    bool steal(int tid, int& v)
+    {
+        for (int i = 1; i < num_threads; ++i) {
+            WorkQueue& victim = queues[(tid + i) % num_threads];
+            std::lock_guard<std::mutex> guard(victim.lock);
+            if (!victim.items.empty()) {
+                v = victim.items.front();
+                victim.items.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Pushes u's excess to its lowest residual neighbors, relabeling u when
+    // none of them is lower. Only the thread owning u changes its height or
+    // decreases its excess and its outgoing residual capacities.
+    void discharge(int u, int tid, long long& pushes, long long& relabels)
+    {
+        long long u_excess = excess[u].load();
+        while (u_excess > 0 && !stop.load(std::memory_order_relaxed)) {
+            int u_height = height[u].load(std::memory_order_relaxed);
+
+            Edge* lowest = nullptr;
+            int lowest_height = NO_HEIGHT;
+            for (Edge& edge : graph.get_outgoing_edges(u)) {
+                if (load_capacity(edge) <= 0)
+                    continue;
+                int h = height[edge.to].load(std::memory_order_relaxed);
+                if (h < lowest_height) {
+                    lowest_height = h;
+                    lowest = &edge;
+                }
+            }
+            if (!lowest)
+                break;
+
+            if (u_height > lowest_height) {
+                int v = lowest->to;
+                int delta = static_cast<int>(
+                    std::min<long long>(u_excess, load_capacity(*lowest)));
+                add_capacity(*lowest, -delta);
+                add_capacity(*graph.get_reverse(*lowest), delta);
+                excess[u].fetch_sub(delta);
+                excess[v].fetch_add(delta);
+                pushes++;
+
+                if (v != source && v != sink)
+                    activate(v, tid);
+            } else {
+                height[u].store(lowest_height + 1, std::memory_order_relaxed);
+                relabels++;
+                if (relabels_since_global.fetch_add(1, std::memory_order_relaxed) >= n)
+                    stop.store(true, std::memory_order_relaxed);
+            }
+
+            u_excess = excess[u].load();
+        }
+    }
+
+    void worker(int tid)
+    {
+        long long pushes = 0, relabels = 0;
+
+        while (!stop.load(std::memory_order_relaxed)) {
+            int u;
+            if (!pop_own(tid, u) && !steal(tid, u)) {
+                if (num_active.load() == 0)
+                    break;
+                std::this_thread::yield();
+                continue;
+            }
+
+            discharge(u, tid, pushes, relabels);
+
+            // Another thread may have added excess to u after the discharge
+            queued[u].store(0);
+            char expected = 0;
+            if (!stop.load(std::memory_order_relaxed) && excess[u].load() > 0 &&
+                queued[u].compare_exchange_strong(expected, 1)) {
+                std::lock_guard<std::mutex> guard(queues[tid].lock);
+                queues[tid].items.push_back(u);
+            } else {
+                num_active--;
+            }
+        }
+
+#pragma omp atomic
+        stats.pushes += pushes;
+#pragma omp atomic
+        stats.relabels += relabels;
+    }
+};
+
+}  // namespace
+
+FordResult parallel_push_relabel(Graph& graph, int source, int sink)
+{
+    PushRelabelEngine engine(graph, source, sink);
+    return engine.run();
+}
@@ -0,0 +1,229 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <random>
+
+#include "ford_fulk.hpp"
+#include "graph.hpp"
+#include "heap.hpp"
+#include "path_finding.hpp"
+#include "perf_counters.hpp"
+
+// Micro-benchmarks for the individual kernels of the solver. Graph benchmarks
+// run over the datasets produced by scripts/gen_datasets.sh, read from
+// $GRAPHS_DIR (default ./data/graphs).
+
+namespace
+{
+
+// Graph families and dataset indices (smallest to largest instance of each
+// family, all with the same aspect ratio)
+const std::vector<std::string> FAMILIES = {"mesh", "matching", "random_mesh"};
+const std::vector<int> SIZES = {3, 9, 15, 21, 27};
+
+// Raw DIMACS text and parsed graph of a dataset file, loaded once, plus the
+// graph renumbered in BFS and Reverse Cuthill-McKee order
+struct Dataset {
+    std::string text;
+    std::unique_ptr<Graph> graph;
+    std::unique_ptr<Graph> bfs_ordered;
+    std::unique_ptr<Graph> rcm_ordered;
+};
+
+std::map<std::string, Dataset> datasets;
+
+// Loads a dataset into memory, returning nullptr if the file is missing
+Dataset *load_dataset(const std::filesystem::path &path)
+{
+    auto it = datasets.find(path.string());
+    if (it != datasets.end())
+        return &it->second;
+
+    std::ifstream input(path);
+    if (!input.is_open())
+        return nullptr;
+
+    Dataset dataset;
+    dataset.text.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    std::istringstream in(dataset.text);
+    dataset.graph = std::make_unique<Graph>(in);
+    dataset.bfs_ordered = std::make_unique<Graph>(dataset.graph.get());
+    dataset.bfs_ordered->reorder_vertices(VertexOrder::Bfs);
+    dataset.rcm_ordered = std::make_unique<Graph>(dataset.graph.get());
+    dataset.rcm_ordered->reorder_vertices(VertexOrder::ReverseCuthillMcKee);
+    return &datasets.emplace(path.string(), std::move(dataset)).first->second;
+}
+
+void add_graph_counters(benchmark::State &state, const Graph &graph)
+{
+    state.counters["n"] = graph.get_total_vertices();
+    state.counters["m"] = graph.get_total_arcs();
+}
+
+void BM_ReadDimacs(benchmark::State &state, Dataset *dataset)
+{
+    for (auto _ : state) {
+        std::istringstream in(dataset->text);
+        Graph graph(in);
+        benchmark::DoNotOptimize(graph);
+    }
+    state.SetBytesProcessed(state.iterations() * dataset->text.size());
+    add_graph_counters(state, *dataset->graph);
+}
+
+void BM_GraphCopy(benchmark::State &state, Dataset *dataset)
+{
+    for (auto _ : state) {
+        Graph copy(dataset->graph.get());
+        benchmark::DoNotOptimize(copy);
+    }
+    add_graph_counters(state, *dataset->graph);
+}
+
+void BM_GraphReset(benchmark::State &state, Dataset *dataset)
+{
+    for (auto _ : state) {
+        dataset->graph->reset_residual();
+        benchmark::ClobberMemory();
+    }
+    add_graph_counters(state, *dataset->graph);
+}
+
+// Path searches only read the residual graph, so every iteration searches the
+// same (zero flow) residual network. Cache misses per search are reported when
+// hardware counters are available.
+void BM_PathSearch(benchmark::State &state, Graph *graph, SearchFunction search)
+{
+    PerfCounters perf;
+    long long visited_arcs = 0;
+    for (auto _ : state) {
+        perf.start();
+        FlowPath result = search(*graph, graph->get_source(), graph->get_sink());
+        perf.stop(Phase::Search);
+        visited_arcs += result.stats.visited_arcs;
+        benchmark::DoNotOptimize(result);
+    }
+    state.counters["arcs/s"] = benchmark::Counter(visited_arcs, benchmark::Counter::kIsRate);
+    if (perf.is_available()) {
+        const PerfStats &stats = perf.get_stats();
+        state.counters["l1d_misses"] = benchmark::Counter(
+            stats.get(Phase::Search, PerfEvent::L1DMisses), benchmark::Counter::kAvgIterations);
+        state.counters["llc_misses"] = benchmark::Counter(
+            stats.get(Phase::Search, PerfEvent::LLCMisses), benchmark::Counter::kAvgIterations);
+    }
+    add_graph_counters(state, *graph);
+}
+
+// Random keys shared by the heap benchmarks
+std::vector<int> random_keys(int n)
+{
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(1, 1000000);
+    std::vector<int> keys(n);
+    for (int &key : keys) key = dist(rng);
+    return keys;
+}
+
+void BM_KHeapInsert(benchmark::State &state)
+{
+    const int n = state.range(0);
+    std::vector<int> keys = random_keys(n);
+    for (auto _ : state) {
+        KHeap heap(n, 8);
+        for (int v = 0; v < n; ++v) heap.insert(v, keys[v], NO_ARC);
+        benchmark::DoNotOptimize(heap);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_KHeapUpdate(benchmark::State &state)
+{
+    const int n = state.range(0);
+    std::vector<int> keys = random_keys(n);
+    for (auto _ : state) {
+        state.PauseTiming();
+        KHeap heap(n, 8);
+        for (int v = 0; v < n; ++v) heap.insert(v, keys[v], NO_ARC);
+        state.ResumeTiming();
+
+        // Increase every key, as Fattest Path does when it finds a fatter path
+        for (int v = 0; v < n; ++v) heap.update(v, keys[v] + 1000000, NO_ARC);
+        benchmark::DoNotOptimize(heap);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_KHeapDeletemax(benchmark::State &state)
+{
+    const int n = state.range(0);
+    std::vector<int> keys = random_keys(n);
+    for (auto _ : state) {
+        state.PauseTiming();
+        KHeap heap(n, 8);
+        for (int v = 0; v < n; ++v) heap.insert(v, keys[v], NO_ARC);
+        state.ResumeTiming();
+
+        while (heap.get_size() > 0) benchmark::DoNotOptimize(heap.deletemax());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void register_graph_benchmarks()
+{
+    const char *env_dir = std::getenv("GRAPHS_DIR");
+    std::filesystem::path graphs_dir = env_dir ? env_dir : "./data/graphs";
+
+    for (const std::string &family : FAMILIES) {
+        for (int size : SIZES) {
+            std::filesystem::path path =
+                graphs_dir / family / ("test_" + std::to_string(size) + ".graph");
+            Dataset *dataset = load_dataset(path);
+            if (!dataset) {
+                std::cerr << "Skipping missing dataset " << path << "\n";
+                continue;
+            }
+
+            std::string suffix = "/" + family + "/test_" + std::to_string(size);
+            benchmark::RegisterBenchmark(("BM_ReadDimacs" + suffix).c_str(), BM_ReadDimacs,
+                                         dataset);
+            benchmark::RegisterBenchmark(("BM_GraphCopy" + suffix).c_str(), BM_GraphCopy,
+                                         dataset);
+            benchmark::RegisterBenchmark(("BM_GraphReset" + suffix).c_str(), BM_GraphReset,
+                                         dataset);
+            benchmark::RegisterBenchmark(("BM_BfsPath" + suffix).c_str(), BM_PathSearch,
+                                         dataset->graph.get(), bfs_path);
+            benchmark::RegisterBenchmark(("BM_BfsPathBfsOrder" + suffix).c_str(), BM_PathSearch,
+                                         dataset->bfs_ordered.get(), bfs_path);
+            benchmark::RegisterBenchmark(("BM_BfsPathRcmOrder" + suffix).c_str(), BM_PathSearch,
+                                         dataset->rcm_ordered.get(), bfs_path);
+            benchmark::RegisterBenchmark(("BM_RandomizedDfsPath" + suffix).c_str(),
+                                         BM_PathSearch, dataset->graph.get(),
+                                         get_search_function(Algorithm::RandomizedDFS));
+            benchmark::RegisterBenchmark(("BM_ModifiedDijkstraPath" + suffix).c_str(),
+                                         BM_PathSearch, dataset->graph.get(),
+                                         modified_dijkstra_path);
+        }
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BM_KHeapInsert)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK(BM_KHeapUpdate)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK(BM_KHeapDeletemax)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+
+int main(int argc, char **argv)
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+
+    register_graph_benchmarks();
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,37 @@
+#include "arena.hpp"
+
+#include <algorithm>
+
+Arena::Arena(size_t slab_bytes) { add_chunk(slab_bytes); }
+
+void* Arena::allocate(size_t bytes, size_t alignment)
+{
+    void* block = cursor;
+    if (!std::align(alignment, bytes, block, remaining)) {
+        // Overflow: grow geometrically so repeated misses stay cheap
+        add_chunk(std::max(bytes + alignment, reserved_bytes));
+        block = cursor;
+        std::align(alignment, bytes, block, remaining);
+    }
+
+    char* start = static_cast<char*>(block);
+    used_bytes += (start - cursor) + bytes;
+    cursor = start + bytes;
+    remaining -= bytes;
+    return start;
+}
+
+size_t Arena::get_reserved_bytes() const { return reserved_bytes; }
+
+size_t Arena::get_used_bytes() const { return used_bytes; }
+
+size_t Arena::get_chunk_count() const { return chunks.size(); }
+
+void Arena::add_chunk(size_t bytes)
+{
+    bytes = std::max<size_t>(bytes, 1);
+    chunks.emplace_back(new char[bytes]);
+    cursor = chunks.back().get();
+    remaining = bytes;
+    reserved_bytes += bytes;
+}
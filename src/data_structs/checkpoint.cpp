@@ -0,0 +1,142 @@
+#include "checkpoint.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+Checkpointer::Checkpointer(const std::string &path, int every_iterations, double every_seconds)
+    : path(path),
+      every_iterations(every_iterations),
+      every_seconds(every_seconds),
+      last_time(std::chrono::steady_clock::now()),
+      writer(&Checkpointer::write_loop, this)
+{
+}
+
+Checkpointer::~Checkpointer()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    changed.notify_all();
+    writer.join();
+}
+
+const SolveProgress &Checkpointer::get_resumed() const { return resumed; }
+
+void Checkpointer::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [&] { return !pending; });
+}
+
+int Checkpointer::get_written() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return written;
+}
+
+int Checkpointer::get_failed() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return failed;
+}
+
+bool Checkpointer::is_due(int iterations) const
+{
+    if (every_iterations > 0 && iterations - last_iterations >= every_iterations)
+        return true;
+    if (every_seconds > 0) {
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - last_time;
+        return elapsed.count() >= every_seconds;
+    }
+    return false;
+}
+
+bool Checkpointer::is_idle() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return !pending;
+}
+
+void Checkpointer::submit(const SolveProgress &progress)
+{
+    last_iterations = progress.iterations;
+    last_time = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending_progress = progress;
+        pending = true;
+    }
+    changed.notify_all();
+}
+
+bool Checkpointer::read(uint64_t expected_fingerprint, std::vector<int> &residual)
+{
+    std::ifstream in(path, std::ios::binary);
+    CheckpointFileHeader header;
+    if (!in.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, "FFCKPT", 7) != 0 || header.version != 1 ||
+        header.fingerprint != expected_fingerprint) {
+        return false;
+    }
+
+    residual.resize(header.num_arcs);
+    if (!in.read(reinterpret_cast<char *>(residual.data()), residual.size() * sizeof(int32_t)))
+        return false;
+
+    resumed = SolveProgress{header.max_flow, header.iterations};
+    fingerprint = expected_fingerprint;
+    has_fingerprint = true;
+    last_iterations = resumed.iterations;
+    last_time = std::chrono::steady_clock::now();
+    return true;
+}
+
+void Checkpointer::write_loop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        changed.wait(lock, [&] { return pending || stopping; });
+        if (!pending)
+            return;
+
+        // The solve thread leaves the snapshot alone while it is pending
+        const SolveProgress progress = pending_progress;
+        lock.unlock();
+        const bool ok = write_file(progress);
+        lock.lock();
+
+        ok ? written++ : failed++;
+        pending = false;
+        changed.notify_all();
+    }
+}
+
+bool Checkpointer::write_file(const SolveProgress &progress) const
+{
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary);
+        if (!out.is_open()) {
+            return false;
+        }
+
+        CheckpointFileHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, "FFCKPT", 7);
+        header.version = 1;
+        header.num_arcs = snapshot.size();
+        header.fingerprint = fingerprint;
+        header.max_flow = progress.max_flow;
+        header.iterations = progress.iterations;
+
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char *>(snapshot.data()),
+                  snapshot.size() * sizeof(int32_t));
+        if (!out.good())
+            return false;
+    }
+    return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
@@ -0,0 +1,244 @@
+#include "compressed_graph.hpp"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+
+namespace
+{
+
+// One end of an arc, as seen from the vertex at that end
+struct Neighbor {
+    unsigned other;     // Vertex at the other end
+    unsigned capacity;  // Capacity of the arc at the tail end, 0 at the head end
+};
+
+// Maps 0, -1, 1, -2, 2... to 0, 1, 2, 3, 4...
+uint32_t zigzag(int value)
+{
+    return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+}
+
+// Bytes taken by the varint of a value
+size_t varint_size(uint32_t value)
+{
+    size_t size = 1;
+    for (; value >= 0x80; value >>= 7) size++;
+    return size;
+}
+
+// Writes the varint of a value, moving p past it
+void write_varint(uint8_t*& p, uint32_t value)
+{
+    for (; value >= 0x80; value >>= 7) *p++ = static_cast<uint8_t>(value | 0x80);
+    *p++ = static_cast<uint8_t>(value);
+}
+
+}  // namespace
+
+CompressedGraph::CompressedGraph(std::istream& in)
+{
+    DimacsInput input = parse_dimacs(in);
+    if (input.sources.size() != 1 || input.sinks.size() != 1)
+        throw std::invalid_argument("The compressed layout needs a single source and sink");
+    num_vertices_ = input.num_vertices;
+    num_arcs_ = input.num_arcs;
+    source = input.sources.front();
+    sink = input.sinks.front();
+
+    const size_t n = num_vertices_;
+    const int num_buffers = input.buffers.size();
+    std::vector<size_t> buffer_offsets(num_buffers + 1, 0);
+    for (int b = 0; b < num_buffers; ++b)
+        buffer_offsets[b + 1] = buffer_offsets[b] + input.buffers[b].size();
+    auto kept = [&](int b) {
+        return std::min(buffer_offsets[b + 1], input.num_kept) -
+               std::min(buffer_offsets[b], input.num_kept);
+    };
+
+    // (1) count both ends of every arc but self-loops
+    std::vector<size_t> first(n + 1, 0);
+#pragma omp parallel for schedule(static, 1)
+    for (int b = 0; b < num_buffers; ++b) {
+        for (size_t i = 0; i < kept(b); ++i) {
+            const ParsedArc& arc = input.buffers[b][i];
+            if (arc.tail == arc.head)
+                continue;
+#pragma omp atomic
+            first[arc.tail + 1]++;
+#pragma omp atomic
+            first[arc.head + 1]++;
+        }
+    }
+    for (size_t v = 0; v < n; ++v) first[v + 1] += first[v];
+
+    // (2) counting sort of both ends by vertex; the parsed arcs are then dropped
+    std::vector<size_t> cursor(first.begin(), first.end() - 1);
+    std::unique_ptr<Neighbor[]> ends(new Neighbor[first[n]]);
+#pragma omp parallel for schedule(static, 1)
+    for (int b = 0; b < num_buffers; ++b) {
+        for (size_t i = 0; i < kept(b); ++i) {
+            const ParsedArc& arc = input.buffers[b][i];
+            if (arc.tail == arc.head)
+                continue;
+            size_t slot;
+#pragma omp atomic capture
+            slot = cursor[arc.tail]++;
+            ends[slot] = Neighbor{arc.head, arc.capacity};
+#pragma omp atomic capture
+            slot = cursor[arc.head]++;
+            ends[slot] = Neighbor{arc.tail, 0};
+        }
+    }
+    std::vector<std::vector<ParsedArc>>().swap(input.buffers);
+    std::vector<size_t>().swap(cursor);
+
+    // (3) sort the ends of every vertex by neighbor and merge the repeated
+    //     ones in place, summing their capacities; measure the encoded lists
+    std::vector<ArcId> degrees(n, 0);
+    std::vector<uint64_t> sizes(n, 0);
+#pragma omp parallel for schedule(dynamic, 1024)
+    for (size_t v = 0; v < n; ++v) {
+        Neighbor* begin = ends.get() + first[v];
+        Neighbor* end = ends.get() + first[v + 1];
+        std::sort(begin, end,
+                  [](const Neighbor& a, const Neighbor& b) { return a.other < b.other; });
+
+        Neighbor* last = begin;
+        for (Neighbor* it = begin; it != end; ++it) {
+            if (it != begin && it->other == (last - 1)->other) {
+                (last - 1)->capacity += it->capacity;
+                continue;
+            }
+            sizes[v] += (it == begin) ? varint_size(zigzag(static_cast<int>(it->other - v)))
+                                      : varint_size(it->other - (last - 1)->other - 1);
+            *last++ = *it;
+        }
+        degrees[v] = last - begin;
+    }
+
+    // (4) lay the lists out one after the other and encode them
+    first_arc.assign(n + 1, 0);
+    offsets.assign(n + 1, 0);
+    for (size_t v = 0; v < n; ++v) {
+        first_arc[v + 1] = first_arc[v] + degrees[v];
+        offsets[v + 1] = offsets[v] + sizes[v];
+    }
+    neighbors.resize(offsets[n]);
+    original_capacities.resize(first_arc[n]);
+#pragma omp parallel for schedule(dynamic, 1024)
+    for (size_t v = 0; v < n; ++v) {
+        const Neighbor* list = ends.get() + first[v];
+        uint8_t* p = neighbors.data() + offsets[v];
+        for (ArcId i = 0; i < degrees[v]; ++i) {
+            write_varint(p, i == 0 ? zigzag(static_cast<int>(list[i].other - v))
+                                   : list[i].other - list[i - 1].other - 1);
+            original_capacities[first_arc[v] + i] = list[i].capacity;
+        }
+    }
+    capacity = original_capacities;
+    num_arcs_ += first_arc[n] / 2;
+}
+
+int CompressedGraph::get_arc_tail(ArcId arc) const
+{
+    return std::upper_bound(first_arc.begin(), first_arc.end(), arc) - first_arc.begin() - 1;
+}
+
+int CompressedGraph::get_arc_head(ArcId arc) const
+{
+    int head = -1;
+    visit_arcs(get_arc_tail(arc), [&](ArcId current, int to, int) {
+        head = to;
+        return current != arc;
+    });
+    return head;
+}
+
+ArcId CompressedGraph::get_reverse(ArcId arc) const
+{
+    const int tail = get_arc_tail(arc);
+    ArcId reverse = NO_ARC;
+    visit_arcs(get_arc_head(arc), [&](ArcId current, int to, int) {
+        if (to == tail)
+            reverse = current;
+        return to < tail;
+    });
+    return reverse;
+}
+
+void CompressedGraph::push_flow(ArcId arc, int flow)
+{
+    capacity[arc] -= flow;
+    capacity[get_reverse(arc)] += flow;
+}
+
+int CompressedGraph::compute_upper_flow_bound(int source, int sink) const
+{
+    int src_limit = 0, sink_limit = 0;
+
+    // Sum capacities of arcs leaving the source
+    visit_arcs(source, [&](ArcId, int, int residual) {
+        src_limit += residual;
+        return true;
+    });
+
+    // Sum capacities of arcs entering the sink (the reverses of the ones leaving it)
+    visit_arcs(sink, [&](ArcId arc, int, int) {
+        sink_limit += capacity[get_reverse(arc)];
+        return true;
+    });
+
+    return std::min(src_limit, sink_limit);
+}
+
+void CompressedGraph::reset_residual() { capacity = original_capacities; }
+
+void CompressedGraph::save_residual(std::vector<int>& residual) const { residual = capacity; }
+
+void CompressedGraph::load_residual(const std::vector<int>& residual) { capacity = residual; }
+
+uint64_t CompressedGraph::get_fingerprint() const
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    auto mix = [&](uint32_t value) {
+        for (int byte = 0; byte < 4; ++byte, value >>= 8) {
+            hash = (hash ^ (value & 0xff)) * 0x100000001b3ULL;
+        }
+    };
+    mix(num_vertices_);
+    mix(source);
+    mix(sink);
+    for (ArcId first : first_arc) mix(first);
+    for (uint8_t byte : neighbors) mix(byte);
+    for (int original : original_capacities) mix(original);
+    return hash;
+}
+
+size_t CompressedGraph::get_topology_bytes() const
+{
+    return neighbors.size() + offsets.size() * sizeof(uint64_t) +
+           first_arc.size() * sizeof(ArcId);
+}
+
+size_t CompressedGraph::get_capacity_bytes() const
+{
+    return (capacity.size() + original_capacities.size()) * sizeof(int);
+}
+
+size_t CompressedGraph::get_uncompressed_bytes() const
+{
+    const size_t arcs = first_arc[num_vertices_];
+    return arcs * (sizeof(Edge) + 2 * sizeof(int)) +
+           num_vertices_ * (sizeof(EdgeList) + sizeof(ArcId));
+}
+
+int CompressedGraph::get_source() const { return source; }
+
+int CompressedGraph::get_sink() const { return sink; }
+
+int CompressedGraph::get_total_vertices() const { return num_vertices_; }
+
+int CompressedGraph::get_total_arcs() const { return num_arcs_; }
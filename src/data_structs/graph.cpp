@@ -1,29 +1,91 @@
 #include "graph.hpp"
 
-Graph::Graph(){};
+#include <omp.h>
 
-Graph::Graph(std::istream& in) { read_dimacs(in); };
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
 
-// Copy constructor for the Graph class
-Graph::Graph(Graph* graph)
+namespace
 {
-    // Copy the basic attributes
-    this->num_vertices_ = graph->num_vertices_;
-    this->num_arcs_ = graph->num_arcs_;
-    this->source = graph->source;
-    this->sink = graph->sink;
 
-    // Create a deep copy of the adjacency list
-    this->adjacency_list.resize(graph->adjacency_list.size());
-    for (size_t i = 0; i < graph->adjacency_list.size(); ++i) {
-        for (const Edge& edge : graph->adjacency_list[i]) {
-            this->adjacency_list[i].emplace_back(edge.to, edge.capacity, edge.reverse_idx);
+// Inputs are split in chunks of at least this many bytes, one per thread
+constexpr size_t MIN_CHUNK_BYTES = 1 << 20;
+
+// Lines of a DIMACS input parsed by one thread
+struct ParsedChunk {
+    std::vector<ParsedArc> arcs;                            // "a" lines, in input order
+    std::vector<std::pair<size_t, std::string>> terminals;  // "n" lines and the arcs before them
+};
+
+// One end of an arc, as seen from the vertex at that end. The code is twice
+// the arc's position in the input, plus one at the head end.
+struct Incidence {
+    unsigned code;
+    unsigned other;     // Vertex at the other end
+    unsigned capacity;  // Capacity of the arc at the tail end, 0 at the head end
+};
+
+// Reads everything left in a stream: seekable streams (files) in one read of
+// their remaining length, others (pipes) block by block
+std::string read_remaining(std::istream& in)
+{
+    std::string buffer;
+    const std::streampos start = in.tellg();
+    if (start != std::streampos(-1) && in.seekg(0, std::ios::end)) {
+        const std::streampos end = in.tellg();
+        in.seekg(start);
+        buffer.resize(end - start);
+        in.read(&buffer[0], buffer.size());
+        buffer.resize(in.gcount());
+        return buffer;
+    }
+
+    in.clear();
+    char block[1 << 16];
+    while (in.read(block, sizeof(block)) || in.gcount() > 0) buffer.append(block, in.gcount());
+    buffer.shrink_to_fit();
+    return buffer;
+}
+
+// Reads a decimal number, skipping the blanks in front of it
+unsigned parse_unsigned(const char*& p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+    unsigned value = 0;
+    for (; p < end && *p >= '0' && *p <= '9'; ++p) value = value * 10 + (*p - '0');
+    return value;
+}
+
+// Parses the "a " and "n " lines of [begin, end), which holds whole lines
+void parse_chunk(const char* begin, const char* end, ParsedChunk& chunk)
+{
+    for (const char* line = begin; line < end;) {
+        const char* line_end = static_cast<const char*>(std::memchr(line, '\n', end - line));
+        if (!line_end)
+            line_end = end;
+
+        if (line_end - line >= 2 && line[1] == ' ') {
+            if (line[0] == 'a') {
+                const char* p = line + 2;
+                ParsedArc arc;
+                arc.tail = parse_unsigned(p, line_end) - 1;
+                arc.head = parse_unsigned(p, line_end) - 1;
+                arc.capacity = parse_unsigned(p, line_end);
+                chunk.arcs.push_back(arc);
+            } else if (line[0] == 'n') {
+                chunk.terminals.emplace_back(chunk.arcs.size(), std::string(line, line_end));
+            }
         }
+        line = line_end + 1;
     }
 }
 
-void Graph::read_dimacs(std::istream& in)
+}  // namespace
+
+DimacsInput parse_dimacs(std::istream& in)
 {
+    DimacsInput input;
     std::string line = "", dummy;
     std::stringstream linestr;
 
@@ -32,47 +94,105 @@ void Graph::read_dimacs(std::istream& in)
         if (line.substr(0, 5) == "p max") {
             linestr.clear();
             linestr.str(line);
-            linestr >> dummy >> dummy >> num_vertices_ >> num_arcs_;
+            linestr >> dummy >> dummy >> input.num_vertices >> input.num_arcs;
             break;
         }
     }
 
-    // (1) find source node (first "n " line)
-    while (std::getline(in, line)) {
-        if (line.substr(0, 2) == "n ") {
-            linestr.clear();
-            linestr.str(line);
-            linestr >> dummy >> source;
-            source--;
-            break;
-        }
+    // (1) split the rest of the input at line boundaries, one chunk per thread
+    //     (small inputs stay on one), and parse every chunk into its own buffers
+    const std::string buffer = read_remaining(in);
+    const int num_chunks = std::max<size_t>(
+        1, std::min<size_t>(omp_get_max_threads(), buffer.size() / MIN_CHUNK_BYTES));
+    std::vector<size_t> bounds(num_chunks + 1, buffer.size());
+    bounds[0] = 0;
+    for (int c = 1; c < num_chunks; ++c) {
+        size_t newline = buffer.find('\n', std::max(bounds[c - 1], buffer.size() * c / num_chunks));
+        bounds[c] = (newline == std::string::npos) ? buffer.size() : newline + 1;
     }
 
-    // (2) find sink node (second "n " line)
-    while (std::getline(in, line)) {
-        if (line.substr(0, 2) == "n ") {
+    std::vector<ParsedChunk> chunks(num_chunks);
+#pragma omp parallel for schedule(static, 1) num_threads(num_chunks)
+    for (int c = 0; c < num_chunks; ++c) {
+        chunks[c].arcs.reserve(input.num_arcs / num_chunks + 1);
+        parse_chunk(buffer.data() + bounds[c], buffer.data() + bounds[c + 1], chunks[c]);
+    }
+
+    // (2) terminals ("n <id> s" / "n <id> t"), wherever they are listed. Only
+    //     the number of arcs stated by the header is kept. Unlabeled lines keep
+    //     the old convention: the first is the source, the second the sink.
+    size_t arcs_read = 0;
+    input.buffers.resize(num_chunks);
+    for (int c = 0; c < num_chunks; ++c) {
+        for (const auto& [arcs_before, terminal_line] : chunks[c].terminals) {
+            int id;
+            std::string role;
             linestr.clear();
-            linestr.str(line);
-            linestr >> dummy >> sink;
-            sink--;
-            break;
+            linestr.str(terminal_line);
+            linestr >> dummy >> id >> role;
+            const bool is_sink = (role == "t") || (role.empty() && !input.sources.empty());
+            (is_sink ? input.sinks : input.sources).push_back(id - 1);
         }
+        arcs_read += chunks[c].arcs.size();
+        input.buffers[c] = std::move(chunks[c].arcs);
     }
+    input.num_kept = std::min<size_t>(arcs_read, input.num_arcs);
 
-    resize(num_vertices_);
-    unsigned i = 0;
-    // (3) process and store arcs (all "a " lines)
-    while (getline(in, line) && i < num_arcs_) {
-        if (line.substr(0, 2) == "a ") {
-            std::stringstream arc(line);
-            unsigned u, v, w;
-            char ac;
-            arc >> ac >> u >> v >> w;
-            // process arc u-v with capacity w
-            add_edge(u - 1, v - 1, w);
-            ++i;
+    if (input.sources.empty())
+        throw std::invalid_argument("The graph lists no source");
+    if (input.sinks.empty())
+        throw std::invalid_argument("The graph lists no sink");
+    return input;
+}
+
+Graph::Graph(){};
+
+Graph::Graph(std::istream& in) { read_dimacs(in); };
+
+// Copy constructor for the Graph class
+Graph::Graph(Graph* graph)
+{
+    // Copy the basic attributes
+    this->num_vertices_ = graph->num_vertices_;
+    this->num_arcs_ = graph->num_arcs_;
+    this->source = graph->source;
+    this->sink = graph->sink;
+
+    // Create a deep copy of the adjacency list in a slab of the exact size
+    std::vector<size_t> degrees;
+    degrees.reserve(graph->adjacency_list.size());
+    for (const EdgeList& edges : graph->adjacency_list) degrees.push_back(edges.size());
+    allocate_adjacency(degrees);
+    for (size_t i = 0; i < graph->adjacency_list.size(); ++i) {
+        for (const Edge& edge : graph->adjacency_list[i]) {
+            this->adjacency_list[i].emplace_back(edge.to, edge.capacity, edge.reverse_idx);
         }
     }
+    this->original_capacities = graph->original_capacities;
+    this->first_arc = graph->first_arc;
+    this->arc_tails = graph->arc_tails;
+    this->sources = graph->sources;
+    this->sinks = graph->sinks;
+    this->terminal_role = graph->terminal_role;
+    this->unit_bipartite_ = graph->unit_bipartite_;
+}
+
+void Graph::read_dimacs(std::istream& in)
+{
+    DimacsInput input = parse_dimacs(in);
+    num_vertices_ = input.num_vertices;
+    num_arcs_ = input.num_arcs;
+    sources = std::move(input.sources);
+    sinks = std::move(input.sinks);
+
+    source = sources.front();
+    sink = sinks.front();
+    build_terminal_roles();
+
+    // Merge the per-thread buffers into adjacency lists in one slab
+    build_adjacency(input.buffers, input.num_kept);
+    save_capacities();
+    detect_unit_bipartite();
 
     // std::cout << get_source() << " "
     //           << get_sink() << " "
@@ -80,12 +200,36 @@ void Graph::read_dimacs(std::istream& in)
     //           << get_total_arcs() << std::endl;
 }
 
-std::vector<Edge>& Graph::get_outgoing_edges(int vertex) { return adjacency_list[vertex]; }
+EdgeList& Graph::get_outgoing_edges(int vertex) { return adjacency_list[vertex]; }
 
 int Graph::compute_upper_flow_bound()
+{
+    if (has_terminal_sets())
+        return compute_upper_flow_bound(ALL_TERMINALS, ALL_TERMINALS);
+    return compute_upper_flow_bound(source, sink);
+}
+
+int Graph::compute_upper_flow_bound(int source, int sink)
 {
     int src_limit = 0, sink_limit = 0;
 
+    // Multi-terminal graphs: arcs leaving the source set and entering the sink set
+    if (source == ALL_TERMINALS) {
+        for (int s : sources) {
+            for (const Edge& e : get_outgoing_edges(s)) {
+                if (!is_source_terminal(e.to))
+                    src_limit += e.capacity;
+            }
+        }
+        for (int t : sinks) {
+            for (const Edge& e : get_outgoing_edges(t)) {
+                if (!is_sink_terminal(e.to))
+                    sink_limit += adjacency_list[e.to][e.reverse_idx].capacity;
+            }
+        }
+        return std::min(src_limit, sink_limit);
+    }
+
     // Sum capacities of edges *leaving* the source
     for (const Edge& e : get_outgoing_edges(source)) {
         src_limit += e.capacity;
@@ -100,14 +244,295 @@ int Graph::compute_upper_flow_bound()
     return std::min(src_limit, sink_limit);
 }
 
+void Graph::save_capacities()
+{
+    original_capacities.clear();
+    for (const auto& edges : adjacency_list) {
+        for (const Edge& edge : edges) {
+            original_capacities.push_back(edge.capacity);
+        }
+    }
+    build_arc_index();
+}
+
+void Graph::build_arc_index()
+{
+    first_arc.assign(1, 0);
+    arc_tails.clear();
+    for (size_t v = 0; v < adjacency_list.size(); ++v) {
+        arc_tails.insert(arc_tails.end(), adjacency_list[v].size(), v);
+        first_arc.push_back(arc_tails.size());
+    }
+}
+
+void Graph::reset_residual()
+{
+    const int* capacity = original_capacities.data();
+    for (auto& edges : adjacency_list) {
+        for (Edge& edge : edges) {
+            edge.capacity = *capacity++;
+            edge.num_criticals = 0;
+        }
+    }
+}
+
+void Graph::save_residual(std::vector<int>& residual) const
+{
+    residual.resize(original_capacities.size());
+    int* capacity = residual.data();
+    for (const auto& edges : adjacency_list) {
+        for (const Edge& edge : edges) *capacity++ = edge.capacity;
+    }
+}
+
+void Graph::load_residual(const std::vector<int>& residual)
+{
+    const int* capacity = residual.data();
+    for (auto& edges : adjacency_list) {
+        for (Edge& edge : edges) edge.capacity = *capacity++;
+    }
+}
+
+uint64_t Graph::get_fingerprint() const
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    auto mix = [&](uint32_t value) {
+        for (int byte = 0; byte < 4; ++byte, value >>= 8) {
+            hash = (hash ^ (value & 0xff)) * 0x100000001b3ULL;
+        }
+    };
+    mix(num_vertices_);
+    mix(source);
+    mix(sink);
+    for (int terminal : sources) mix(terminal);
+    for (int terminal : sinks) mix(terminal);
+    for (const auto& edges : adjacency_list) {
+        mix(edges.size());
+        for (const Edge& edge : edges) mix(edge.to);
+    }
+    for (int capacity : original_capacities) mix(capacity);
+    return hash;
+}
+
+bool Graph::set_capacity(int tail, int head, int capacity)
+{
+    const EdgeList& edges = adjacency_list[tail];
+    for (size_t i = 0; i < edges.size(); ++i) {
+        if (edges[i].to == head) {
+            original_capacities[first_arc[tail] + i] = capacity;
+            unit_bipartite_ = false;
+            return true;
+        }
+    }
+    return false;
+}
+
+void Graph::make_undirected()
+{
+    for (unsigned u = 0; u < num_vertices_; ++u) {
+        const EdgeList& edges = adjacency_list[u];
+        for (size_t i = 0; i < edges.size(); ++i) {
+            // Visit each pair once, from its lower endpoint (self-loops never cut)
+            if (edges[i].to <= static_cast<int>(u))
+                continue;
+            int& forward = original_capacities[first_arc[u] + i];
+            int& backward = original_capacities[first_arc[edges[i].to] + edges[i].reverse_idx];
+            forward = backward = forward + backward;
+        }
+    }
+    unit_bipartite_ = false;
+    reset_residual();
+}
+
+std::vector<int> Graph::reorder_vertices(VertexOrder order)
+{
+    const int n = num_vertices_;
+    std::vector<int> sequence;  // Old ids listed in their new order
+    sequence.reserve(n);
+    std::vector<char> placed(n, 0);
+
+    // Breadth-first sweep from root appending every vertex it reaches. Cuthill-
+    // McKee visits the neighbors of each vertex by increasing degree.
+    auto sweep = [&](int root, bool by_degree) {
+        std::vector<int> neighbors;
+        size_t head = sequence.size();
+        sequence.push_back(root);
+        placed[root] = 1;
+        for (; head < sequence.size(); ++head) {
+            neighbors.clear();
+            for (const Edge& e : adjacency_list[sequence[head]]) {
+                if (!placed[e.to]) {
+                    placed[e.to] = 1;
+                    neighbors.push_back(e.to);
+                }
+            }
+            if (by_degree) {
+                std::stable_sort(neighbors.begin(), neighbors.end(), [&](int a, int b) {
+                    return adjacency_list[a].size() < adjacency_list[b].size();
+                });
+            }
+            sequence.insert(sequence.end(), neighbors.begin(), neighbors.end());
+        }
+    };
+
+    switch (order) {
+        case VertexOrder::Input:
+            for (int v = 0; v < n; ++v) sequence.push_back(v);
+            break;
+        case VertexOrder::Bfs:
+            sweep(source, false);
+            for (int v = 0; v < n; ++v)
+                if (!placed[v])
+                    sweep(v, false);
+            break;
+        case VertexOrder::ReverseCuthillMcKee: {
+            // Each component starts from one of its lowest degree vertices
+            std::vector<int> by_degree(n);
+            for (int v = 0; v < n; ++v) by_degree[v] = v;
+            std::stable_sort(by_degree.begin(), by_degree.end(), [&](int a, int b) {
+                return adjacency_list[a].size() < adjacency_list[b].size();
+            });
+            for (int v : by_degree)
+                if (!placed[v])
+                    sweep(v, true);
+            std::reverse(sequence.begin(), sequence.end());
+            break;
+        }
+    }
+
+    std::vector<int> new_id(n);
+    for (int i = 0; i < n; ++i) new_id[sequence[i]] = i;
+
+    // Saved capacities are stored in adjacency order: find each vertex's block
+    std::vector<size_t> offset(n + 1, 0);
+    for (int v = 0; v < n; ++v) offset[v + 1] = offset[v] + adjacency_list[v].size();
+
+    // Reverse indices stay valid: every adjacency list moves as a whole
+    std::vector<EdgeList> permuted(n);
+    std::vector<int> permuted_capacities;
+    permuted_capacities.reserve(original_capacities.size());
+    for (int i = 0; i < n; ++i) {
+        const int old = sequence[i];
+        permuted[i] = std::move(adjacency_list[old]);
+        for (Edge& e : permuted[i]) e.to = new_id[e.to];
+        if (!original_capacities.empty()) {
+            permuted_capacities.insert(permuted_capacities.end(),
+                                       original_capacities.begin() + offset[old],
+                                       original_capacities.begin() + offset[old + 1]);
+        }
+    }
+    adjacency_list.swap(permuted);
+    original_capacities.swap(permuted_capacities);
+    build_arc_index();
+    source = new_id[source];
+    sink = new_id[sink];
+    for (int& s : sources) s = new_id[s];
+    for (int& t : sinks) t = new_id[t];
+    build_terminal_roles();
+    return new_id;
+}
+
+void Graph::detect_unit_bipartite()
+{
+    enum Side : char { NONE, LEFT, RIGHT };
+    unit_bipartite_ = false;
+    if (source == sink)
+        return;
+
+    // Left vertices are fed by the source, right vertices feed the sink
+    std::vector<char> side(num_vertices_, NONE);
+    for (const Edge& e : adjacency_list[source]) {
+        if (e.capacity <= 0)
+            continue;
+        if (e.capacity != 1 || e.to == sink)
+            return;
+        side[e.to] = LEFT;
+    }
+    for (const Edge& e : adjacency_list[sink]) {
+        const int capacity = adjacency_list[e.to][e.reverse_idx].capacity;
+        if (capacity <= 0)
+            continue;
+        if (capacity != 1 || side[e.to] != NONE)
+            return;
+        side[e.to] = RIGHT;
+    }
+
+    // Every positive arc must follow source→left→right→sink
+    for (unsigned u = 0; u < num_vertices_; ++u) {
+        for (const Edge& e : adjacency_list[u]) {
+            if (e.capacity <= 0)
+                continue;
+            const bool layered = (static_cast<int>(u) == source && side[e.to] == LEFT) ||
+                                 (side[u] == LEFT && side[e.to] == RIGHT) ||
+                                 (side[u] == RIGHT && e.to == sink);
+            if (e.capacity != 1 || !layered)
+                return;
+        }
+    }
+    unit_bipartite_ = true;
+}
+
+bool Graph::is_unit_bipartite() const { return unit_bipartite_; }
+
+const Arena* Graph::get_edge_arena() const { return edge_arena.get(); }
+
 int Graph::get_source() const { return this->source; }
 
 int Graph::get_sink() const { return this->sink; }
 
+bool Graph::has_terminal_sets() const { return sources.size() > 1 || sinks.size() > 1; }
+
+const std::vector<int>& Graph::get_sources() const { return sources; }
+
+const std::vector<int>& Graph::get_sinks() const { return sinks; }
+
+void Graph::build_terminal_roles()
+{
+    terminal_role.clear();
+    if (!has_terminal_sets())
+        return;
+    terminal_role.assign(num_vertices_, NO_ROLE);
+    for (int s : sources) terminal_role[s] = SOURCE_ROLE;
+    for (int t : sinks) terminal_role[t] = SINK_ROLE;
+}
+
 int Graph::get_total_vertices() const { return this->num_vertices_; }
 
 int Graph::get_total_arcs() const { return this->num_arcs_; }
 
+ArcId Graph::get_first_arc(int vertex) const { return first_arc[vertex]; }
+
+Edge& Graph::get_arc(ArcId arc)
+{
+    const int tail = arc_tails[arc];
+    return adjacency_list[tail][arc - first_arc[tail]];
+}
+
+int Graph::get_arc_tail(ArcId arc) const { return arc_tails[arc]; }
+
+int Graph::get_residual(ArcId arc) const
+{
+    const int tail = arc_tails[arc];
+    return adjacency_list[tail][arc - first_arc[tail]].capacity;
+}
+
+ArcId Graph::get_reverse_arc(ArcId arc) const
+{
+    const int tail = arc_tails[arc];
+    const Edge& edge = adjacency_list[tail][arc - first_arc[tail]];
+    return first_arc[edge.to] + edge.reverse_idx;
+}
+
+void Graph::push_flow(ArcId arc, int flow)
+{
+    Edge& edge = get_arc(arc);
+    edge.capacity -= flow;
+    get_reverse(edge)->capacity += flow;
+    if (edge.capacity == 0) {
+        edge.num_criticals++;
+    }
+}
+
 Edge* Graph::get_forward(int source_vertex, int edge_index)
 {
     return &adjacency_list[source_vertex][edge_index];
@@ -139,6 +564,130 @@ void Graph::add_edge(int origin, int destiny, int capacity)
 
 void Graph::resize(int n) { adjacency_list.resize(n); }
 
+void Graph::build_adjacency(const std::vector<std::vector<ParsedArc>>& buffers, size_t num_kept)
+{
+    const size_t n = num_vertices_;
+    const int num_buffers = buffers.size();
+    const bool parallel = num_buffers > 1;
+
+    // Input position of the first arc of every buffer
+    std::vector<size_t> offsets(num_buffers + 1, 0);
+    for (int b = 0; b < num_buffers; ++b) offsets[b + 1] = offsets[b] + buffers[b].size();
+    auto kept = [&](int b) {
+        return std::min(offsets[b + 1], num_kept) - std::min(offsets[b], num_kept);
+    };
+
+    // (1) count the edges each arc may add at both endpoints
+    std::vector<size_t> degrees(n, 0);
+    bool self_loops = false;
+#pragma omp parallel for schedule(static, 1) if (parallel) reduction(|| : self_loops)
+    for (int b = 0; b < num_buffers; ++b) {
+        for (size_t i = 0; i < kept(b); ++i) {
+            const ParsedArc& arc = buffers[b][i];
+#pragma omp atomic
+            degrees[arc.tail]++;
+#pragma omp atomic
+            degrees[arc.head]++;
+            self_loops = self_loops || arc.tail == arc.head;
+        }
+    }
+
+    // Merged parallel arcs leave a little slack at the end of their lists
+    allocate_adjacency(degrees);
+
+    // add_edge gives a loop two edges pointing at each other; keep its layout
+    if (self_loops) {
+        for (int b = 0; b < num_buffers; ++b) {
+            for (size_t i = 0; i < kept(b); ++i)
+                add_edge(buffers[b][i].tail, buffers[b][i].head, buffers[b][i].capacity);
+        }
+        return;
+    }
+
+    // (2) counting sort of both ends of every arc by vertex
+    std::vector<size_t> first(n + 1, 0);
+    for (size_t v = 0; v < n; ++v) first[v + 1] = first[v] + degrees[v];
+    std::vector<size_t> cursor(first.begin(), first.end() - 1);
+    std::unique_ptr<Incidence[]> incidences(new Incidence[2 * num_kept]);
+#pragma omp parallel for schedule(static, 1) if (parallel)
+    for (int b = 0; b < num_buffers; ++b) {
+        for (size_t i = 0; i < kept(b); ++i) {
+            const ParsedArc& arc = buffers[b][i];
+            const unsigned code = 2 * (offsets[b] + i);
+            size_t slot;
+#pragma omp atomic capture
+            slot = cursor[arc.tail]++;
+            incidences[slot] = Incidence{code, arc.head, arc.capacity};
+#pragma omp atomic capture
+            slot = cursor[arc.head]++;
+            incidences[slot] = Incidence{code + 1, arc.tail, 0};
+        }
+    }
+
+    // (3) walk the ends of every vertex in input order: the first arc between
+    //     two vertices creates their pair of edges and later ones only add
+    //     capacity, found through a per-thread open addressing table. Each edge
+    //     keeps the code of its first arc in reverse_idx until its twin's
+    //     position is known.
+    constexpr unsigned EMPTY = std::numeric_limits<unsigned>::max();
+    std::unique_ptr<unsigned[]> position(new unsigned[2 * num_kept]);
+    unsigned pairs = 0;
+#pragma omp parallel if (parallel) reduction(+ : pairs)
+    {
+        std::vector<std::pair<unsigned, unsigned>> table;  // (other end, edge index)
+#pragma omp for schedule(dynamic, 1024)
+        for (size_t v = 0; v < n; ++v) {
+            Incidence* begin = incidences.get() + first[v];
+            Incidence* end = incidences.get() + first[v + 1];
+            auto by_code = [](const Incidence& a, const Incidence& b) { return a.code < b.code; };
+            if (parallel && !std::is_sorted(begin, end, by_code))
+                std::sort(begin, end, by_code);
+
+            // At most half full
+            int bits = 1;
+            while ((size_t{1} << bits) < 2 * static_cast<size_t>(end - begin)) bits++;
+            const size_t mask = (size_t{1} << bits) - 1;
+            table.assign(mask + 1, {EMPTY, 0});
+
+            EdgeList& edges = adjacency_list[v];
+            for (const Incidence* it = begin; it != end; ++it) {
+                size_t slot = (it->other * 0x9e3779b97f4a7c15ULL) >> (64 - bits);
+                while (table[slot].first != EMPTY && table[slot].first != it->other)
+                    slot = (slot + 1) & mask;
+
+                if (table[slot].first == it->other) {
+                    edges[table[slot].second].capacity += it->capacity;
+                    continue;
+                }
+                table[slot] = {it->other, static_cast<unsigned>(edges.size())};
+                position[it->code] = edges.size();
+                edges.emplace_back(it->other, it->capacity, it->code);
+                pairs += (it->code & 1) == 0;
+            }
+        }
+
+#pragma omp for schedule(dynamic, 1024)
+        for (size_t v = 0; v < n; ++v) {
+            for (Edge& edge : adjacency_list[v]) edge.reverse_idx = position[edge.reverse_idx ^ 1];
+        }
+    }
+    num_arcs_ += pairs;
+}
+
+void Graph::allocate_adjacency(const std::vector<size_t>& degrees)
+{
+    size_t total = 0;
+    for (size_t degree : degrees) total += degree;
+    edge_arena = std::make_shared<Arena>(total * sizeof(Edge));
+
+    adjacency_list.clear();
+    adjacency_list.reserve(degrees.size());
+    for (size_t degree : degrees) {
+        adjacency_list.emplace_back(ArenaAllocator<Edge>(edge_arena.get()));
+        adjacency_list.back().reserve(degree);
+    }
+}
+
 TournamentGraph::TournamentGraph(std::istream& in) { build_tournament_graph(in); }
 
 void TournamentGraph::build_tournament_graph(std::istream& in)
@@ -209,22 +758,204 @@ void TournamentGraph::build_tournament_graph(std::istream& in)
 
             // Connect pairing vertex to source and participating teams
             ++pairing_vertex_index;
+            this->total_remaining_games += remaining_games;
             this->add_edge(source, pairing_vertex_index, remaining_games);
             this->add_edge(pairing_vertex_index, team_vertex_index, INF);
             this->add_edge(pairing_vertex_index, opponent_vertex, INF);
         }
     }
+    save_capacities();
 }
 
 bool TournamentGraph::team_one_can_win_before_flow() const { return !team_one_cant_win; }
 
-bool TournamentGraph::team_one_can_win_after_flow()
+int TournamentGraph::get_remaining_games() const { return total_remaining_games; }
+
+ReducedGraph::ReducedGraph(Graph& original)
 {
-    // Sum capacities of edges *leaving* the source
-    for (const Edge& e : get_outgoing_edges(get_source())) {
-        if (e.capacity > 0) {
-            return false;
+    const int n = original.get_total_vertices();
+    const int s = original.get_source();
+    const int t = original.get_sink();
+
+    // (1) Forward sweep from the source and backward sweep from the sink
+    auto sweep = [&](int root, bool forward) {
+        std::vector<char> reached(n, 0);
+        std::vector<int> stack = {root};
+        reached[root] = 1;
+        while (!stack.empty()) {
+            int u = stack.back();
+            stack.pop_back();
+            for (Edge& e : original.get_outgoing_edges(u)) {
+                int capacity = forward ? e.capacity : original.get_reverse(e)->capacity;
+                if (capacity > 0 && !reached[e.to]) {
+                    reached[e.to] = 1;
+                    stack.push_back(e.to);
+                }
+            }
+        }
+        return reached;
+    };
+    std::vector<char> keep = sweep(s, true);
+    std::vector<char> reaches_sink = sweep(t, false);
+    for (int v = 0; v < n; ++v) keep[v] = keep[v] && reaches_sink[v];
+    keep[s] = keep[t] = 1;
+
+    // (2) Collect the arcs that can carry flow, each one a chain of one arc
+    struct WorkArc {
+        int tail, head, capacity;
+        int chain_first, chain_last;
+        bool alive;
+    };
+    std::vector<WorkArc> arcs;
+    std::vector<std::vector<int>> in_arcs(n), out_arcs(n);
+    std::vector<int> in_degree(n, 0), out_degree(n, 0);
+
+    auto add_work_arc = [&](int tail, int head, int capacity, int first, int last) {
+        out_arcs[tail].push_back(arcs.size());
+        in_arcs[head].push_back(arcs.size());
+        out_degree[tail]++;
+        in_degree[head]++;
+        arcs.push_back(WorkArc{tail, head, capacity, first, last, true});
+    };
+
+    for (int u = 0; u < n; ++u) {
+        EdgeList& edges = original.get_outgoing_edges(u);
+        for (int i = 0; i < static_cast<int>(edges.size()); ++i) {
+            const Edge& e = edges[i];
+            if (e.capacity <= 0)
+                continue;
+            reduction.original_arcs++;
+            if (!keep[u] || !keep[e.to] || u == t || e.to == s || e.to == u)
+                continue;
+            original_arcs.push_back(ArcLocation{u, i});
+            chain_next.push_back(-1);
+            add_work_arc(u, e.to, e.capacity, original_arcs.size() - 1, original_arcs.size() - 1);
+        }
+    }
+
+    // (3) Contract degree-2 chains and drop vertices left without in or out arcs
+    auto live_arc = [&](const std::vector<int>& list) {
+        for (int a : list)
+            if (arcs[a].alive)
+                return a;
+        return -1;
+    };
+    auto kill_arc = [&](int a, std::vector<int>& worklist) {
+        arcs[a].alive = false;
+        out_degree[arcs[a].tail]--;
+        in_degree[arcs[a].head]--;
+        worklist.push_back(arcs[a].tail);
+        worklist.push_back(arcs[a].head);
+    };
+
+    std::vector<int> worklist;
+    for (int v = 0; v < n; ++v)
+        if (keep[v])
+            worklist.push_back(v);
+
+    while (!worklist.empty()) {
+        int v = worklist.back();
+        worklist.pop_back();
+        if (!keep[v] || v == s || v == t)
+            continue;
+
+        if (in_degree[v] == 0 || out_degree[v] == 0) {
+            for (int a : in_arcs[v])
+                if (arcs[a].alive)
+                    kill_arc(a, worklist);
+            for (int a : out_arcs[v])
+                if (arcs[a].alive)
+                    kill_arc(a, worklist);
+            keep[v] = 0;
+            continue;
+        }
+        if (in_degree[v] != 1 || out_degree[v] != 1)
+            continue;
+
+        int a = live_arc(in_arcs[v]);
+        int b = live_arc(out_arcs[v]);
+        int u = arcs[a].tail, w = arcs[b].head;
+        kill_arc(a, worklist);
+        kill_arc(b, worklist);
+        keep[v] = 0;
+        if (u == w)
+            continue;  // u→v→u can only carry a cycle
+
+        chain_next[arcs[a].chain_last] = arcs[b].chain_first;
+        add_work_arc(u, w, std::min(arcs[a].capacity, arcs[b].capacity), arcs[a].chain_first,
+                     arcs[b].chain_last);
+        reduction.contracted_vertices++;
+    }
+
+    // (4) Renumber the kept vertices and build the compact graph
+    reduced_ids.assign(n, -1);
+    for (int v = 0; v < n; ++v) {
+        if (keep[v]) {
+            reduced_ids[v] = original_ids.size();
+            original_ids.push_back(v);
+        } else if (v != s && v != t) {
+            reduction.pruned_vertices++;
         }
     }
-    return true;
-}
\ No newline at end of file
+    reduction.pruned_vertices -= reduction.contracted_vertices;
+
+    num_vertices_ = original_ids.size();
+    num_arcs_ = 0;
+    source = reduced_ids[s];
+    sink = reduced_ids[t];
+    resize(num_vertices_);
+
+    for (const WorkArc& arc : arcs) {
+        if (arc.alive)
+            num_arcs_++;  // As a DIMACS header would state
+    }
+    edge_arcs.resize(num_vertices_);
+    for (const WorkArc& arc : arcs) {
+        if (!arc.alive)
+            continue;
+        int tail = reduced_ids[arc.tail], head = reduced_ids[arc.head];
+        add_edge(tail, head, arc.capacity);
+
+        // Remember which reduced arcs were merged into each Edge
+        EdgeList& edges = adjacency_list[tail];
+        int index = 0;
+        while (edges[index].to != head) ++index;
+        edge_arcs[tail].resize(edges.size(), -1);
+        reduced_arcs.push_back(ReducedArc{arc.capacity, arc.chain_first, edge_arcs[tail][index]});
+        edge_arcs[tail][index] = reduced_arcs.size() - 1;
+    }
+    for (unsigned v = 0; v < num_vertices_; ++v) edge_arcs[v].resize(adjacency_list[v].size(), -1);
+    save_capacities();
+    detect_unit_bipartite();
+
+    reduction.original_vertices = n;
+    reduction.vertices = num_vertices_;
+    reduction.arcs = reduced_arcs.size();
+}
+
+int ReducedGraph::original_vertex(int vertex) const { return original_ids[vertex]; }
+
+int ReducedGraph::reduced_vertex(int vertex) const { return reduced_ids[vertex]; }
+
+void ReducedGraph::map_flow_back(Graph& original)
+{
+    const int* capacity = original_capacities.data();
+    for (unsigned u = 0; u < num_vertices_; ++u) {
+        for (size_t i = 0; i < adjacency_list[u].size(); ++i) {
+            int flow = *capacity++ - adjacency_list[u][i].capacity;
+
+            // Split the Edge's flow over its arcs, and each arc's over its chain
+            for (int a = edge_arcs[u][i]; a != -1 && flow > 0; a = reduced_arcs[a].next) {
+                int amount = std::min(flow, reduced_arcs[a].capacity);
+                flow -= amount;
+                for (int k = reduced_arcs[a].chain_first; k != -1; k = chain_next[k]) {
+                    Edge* edge = original.get_forward(original_arcs[k].vertex, original_arcs[k].index);
+                    edge->capacity -= amount;
+                    original.get_reverse(*edge)->capacity += amount;
+                }
+            }
+        }
+    }
+}
+
+const ReductionStats& ReducedGraph::get_reduction_stats() const { return reduction; }
@@ -24,16 +24,16 @@ HeapNode KHeap::deletemax()
     return max;
 }
 
-void KHeap::update(int vertex, int capacity, Edge* incoming_edge)
+void KHeap::update(int vertex, int capacity, ArcId incoming_arc)
 {
     int vertex_index = pos[vertex];
-    heap[vertex_index] = HeapNode{vertex, capacity, incoming_edge};
+    heap[vertex_index] = HeapNode{vertex, capacity, incoming_arc};
     heapify_up(vertex_index);
 }
 
-void KHeap::insert(int vertex, int capacity, Edge* incoming_edge)
+void KHeap::insert(int vertex, int capacity, ArcId incoming_arc)
 {
-    heap.push_back(HeapNode{vertex, capacity, incoming_edge});
+    heap.push_back(HeapNode{vertex, capacity, incoming_arc});
     pos[vertex] = heap.size() - 1;
     heapify_up(heap.size() - 1);
 }
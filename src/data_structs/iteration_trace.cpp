@@ -0,0 +1,34 @@
+#include "iteration_trace.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+void IterationTrace::begin(long long expected_iterations)
+{
+    records.clear();
+    records.reserve(std::clamp<long long>(expected_iterations, 0, MAX_RESERVED_RECORDS));
+    start = std::chrono::steady_clock::now();
+}
+
+bool IterationTrace::dump(const std::string &path, int n, int m) const
+{
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) {
+        return false;
+    }
+
+    TraceFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "FFTRACE", 8);
+    header.version = 1;
+    header.record_size = sizeof(IterationRecord);
+    header.num_records = records.size();
+    header.n = n;
+    header.m = m;
+
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(records.data()),
+              records.size() * sizeof(IterationRecord));
+    return out.good();
+}
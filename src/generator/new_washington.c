@@ -6,7 +6,9 @@
 #include <inttypes.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <omp.h>
 #include <stdlib.h>
+#include <string.h>
 #include <strings.h>
 #include <sys/time.h>
 
@@ -22,6 +24,10 @@
 
 #define MAX_CAP 100000000
 
+/* Manifest mode limits */
+#define MAX_LINE 1024
+#define MAX_ARGS 8
+
 /* Dimacs problem types */
 #define UNDEFINED   0
 #define MINCOSTFLOW 1
@@ -54,11 +60,93 @@ typedef struct {
 //#define MAX_DEGREE 50
 #define VERY_BIG 1000000
 
+/* Vertices of a Cheryian graph: terminals, gadgets, bridge and sink */
+#define CHERYIAN_VERTICES(n, m, c) (4 * (m) * (c) + 2 * (n) + 7)
+
 int32_t Range[] = {1000000, 500000, 250000, 125000, 62500, 31250, 15625, 7812, 3906, 1953,
                    976,     488,    244,    122,    61,    31,    15,    7,    4,    2};
 
 main(argc, argv) int argc;
 char *argv[];
+{
+    if (argc < 2)
+        Barf("Usage: makegraph instance_type [specific parameters] | makegraph -m manifest [threads]");
+
+    if (Strcmp(argv[1], "-m")) {
+        if (argc != 3 && argc != 4)
+            Barf("Usage: makegraph -m manifest [threads]");
+        RunManifest(argv[2], (argc == 4) ? atoi(argv[3]) : 0);
+        return 0;
+    }
+
+    InitRandom(1);
+    GenerateInstance(argc, argv);
+    return 0;
+}
+
+/* RunManifest -- generate every instance listed in a manifest file, one per
+   line, using the same arguments as the command line ("type params... file").
+   Blank lines and lines starting with '#' are ignored. Entries are generated
+   concurrently, and each one seeds its own random stream exactly as a
+   standalone run would, so the output does not depend on the thread count.
+*/
+RunManifest(path, threads) char *path;
+int32_t threads;
+{
+    FILE *f;
+    char line[MAX_LINE], **lines;
+    int32_t count, capacity, i;
+
+    if ((f = fopen(path, "r")) == NULL)
+        Barf("Manifest File Error");
+
+    count = 0;
+    capacity = 64;
+    lines = (char **)malloc(capacity * sizeof(char *));
+    while (fgets(line, MAX_LINE, f) != NULL) {
+        char *p = line;
+        while (isspace(*p)) p++;
+        if (*p == 0 || *p == '#')
+            continue;
+        if (count == capacity) {
+            capacity *= 2;
+            if ((lines = (char **)realloc(lines, capacity * sizeof(char *))) == NULL)
+                Barf("Out of space");
+        }
+        lines[count] = strdup(p);
+        count++;
+    }
+    fclose(f);
+
+    if (threads > 0)
+        omp_set_num_threads(threads);
+
+#pragma omp parallel for schedule(dynamic, 1)
+    for (i = 0; i < count; i++) {
+        char *args[MAX_ARGS], *save, *tok;
+        int32_t nargs = 1;
+
+        args[0] = "makegraph";
+        tok = strtok_r(lines[i], " \t\r\n", &save);
+        while (tok != NULL && nargs < MAX_ARGS) {
+            args[nargs++] = tok;
+            tok = strtok_r(NULL, " \t\r\n", &save);
+        }
+
+        InitRandom(1);
+        GenerateInstance(nargs, args);
+    }
+
+    for (i = 0; i < count; i++) free(lines[i]);
+    free(lines);
+}
+
+/* GenerateInstance -- build the graph described by argv (argv[1] is the
+   instance type, followed by its parameters and the output file) and write
+   it in DIMACS format. Uses the calling thread's random stream.
+*/
+GenerateInstance(argc, argv) int32_t argc;
+char *argv[];
 {
     Graph *G, *Mesh(), *RLevel(), *R2Level(), *Match(), *SquareMesh(), *BasicLine(),
         *ExponentialLine(), *DExponentialLine(), *DinicBadCase(), *GoldBadCase(), *Cheryian();
@@ -66,10 +154,6 @@ char *argv[];
     FILE *f;
     int32_t dim1, dim2, range, fct, s, t, deg;
 
-    InitRandom(1);
-
-    if (argc < 2)
-        Barf("Usage: makegraph instance_type [specific parameters]");
     fct = atoi(argv[1]);
 
     if (fct >= 1 && fct <= 5) {
@@ -112,7 +196,8 @@ char *argv[];
 
         if ((f = fopen(argv[6], "w")) == NULL)
             Barf("File Error");
-    }
+    } else
+        Barf("Undefined class");
 
     switch (fct) {
         case 1:
@@ -219,7 +304,7 @@ char *argv[];
             fprintf(f,
                     "c n = %" PRId32 ", m = %" PRId32 ", c = %" PRId32 ", total vertices %" PRId32
                     " \n",
-                    dim1, dim2, deg, 4 * dim2 * deg + 6 + 2 * dim1);
+                    dim1, dim2, deg, CHERYIAN_VERTICES(dim1, dim2, deg));
             G = Cheryian(dim1, dim2, deg, range);
             s = 0;
             t = G->size - 1;
@@ -231,6 +316,8 @@ char *argv[];
     }
 
     GraphOutput(G, f, s, t);
+    fclose(f);
+    FreeGraph(G);
 }
 
 Graph *Mesh(d1, d2, r)
@@ -623,14 +710,16 @@ int32_t n, m, c, very_big;
     // fault. The original author of the code guessed wrong how much memory
     // he/she would need. The correct value seems to be: 4*m*c + 6 + 2*n
     // (that's the number of vertexes).
-    if (4 * m * c + 6 + 2 * n > SIZE_MAX)
+    // Still one short: 4 terminals, m*c per gadget, 2*n + 2 in the bridge and
+    // the sink make 4*m*c + 2*n + 7 (CHERYIAN_VERTICES).
+    if (CHERYIAN_VERTICES(n, m, c) > SIZE_MAX)
         Barf("Graph out of range");
 
     G = (Graph *)malloc(sizeof(Graph));
-    G->A = calloc(4 * m * c + 6 + 2 * n, sizeof(Edge *));
-    G->V = calloc(4 * m * c + 6 + 2 * n, sizeof(int32_t));
+    G->A = calloc(CHERYIAN_VERTICES(n, m, c), sizeof(Edge *));
+    G->V = calloc(CHERYIAN_VERTICES(n, m, c), sizeof(int32_t));
 
-    InitGraph(G, 4 * m * c + 6 + 2 * n);
+    InitGraph(G, CHERYIAN_VERTICES(n, m, c));
 
     AddVertex(0, G);
     AddVertex(1, G);
@@ -712,6 +801,25 @@ int32_t n;
     G->max_v = -1;
 }
 
+/* Release every edge of G together with the graph itself */
+FreeGraph(G) Graph *G;
+{
+    int32_t i;
+    Edge *e, *next;
+
+    for (i = 0; i <= G->max_v; i++) {
+        e = G->A[i];
+        while (e != (Edge *)0) {
+            next = e->next;
+            free(e);
+            e = next;
+        }
+    }
+    free(G->A);
+    free(G->V);
+    free(G);
+}
+
 Graph *CopyGraph(G1)
 Graph *G1;
 {
@@ -1110,12 +1218,23 @@ RandPerm(perm, n) int32_t perm[], n;
     }
 }
 
+/* Each thread draws from its own generator state. The reentrant glibc
+   generator with a 128 byte state yields the same sequence as
+   srandom/random, so single instance output is unchanged.
+*/
+#define RAND_STATE_BYTES 128
+static __thread struct random_data RandData;
+static __thread char RandState[RAND_STATE_BYTES];
+
 /* RandomInteger -- return a random integer from the range low .. high.
  */
 int32_t RandomInteger(low, high)
 int32_t low, high;
 {
-    return random() % (high - low + 1) + low;
+    int32_t r;
+
+    random_r(&RandData, &r);
+    return r % (high - low + 1) + low;
 }
 
 /* InitRandom -- If the seed is non-zero, the random number generator is
@@ -1129,9 +1248,10 @@ InitRandom(seed) int32_t seed;
 
     if (seed == 0) {
         gettimeofday(&tp, 0);
-        srandom(tp.tv_sec + tp.tv_usec);
-    } else
-        srandom(seed);
+        seed = tp.tv_sec + tp.tv_usec;
+    }
+    memset(&RandData, 0, sizeof(RandData));
+    initstate_r(seed, RandState, RAND_STATE_BYTES, &RandData);
 }
 
 /* RandomSubset - return n distinct values, randomly selected between
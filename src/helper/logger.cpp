@@ -5,11 +5,13 @@
 namespace Logger
 {
 
-void log_stats_header(const Algorithm &algo, std::ofstream &output_file)
+void log_stats_header(const Algorithm &algo, std::ofstream &output_file, bool with_perf,
+                      bool with_memory)
 {
     output_file << "n,m,r,T(µs),normalized_T,avg_l,";
     switch (algo) {
         case Algorithm::EdmondsKarp:
+        case Algorithm::ParallelEdmondsKarp:
             output_file << "C,avg_crit,avg_s,avg_t";
             break;
         case Algorithm::RandomizedDFS:
@@ -18,14 +20,43 @@ void log_stats_header(const Algorithm &algo, std::ofstream &output_file)
         case Algorithm::FattestPath:
             output_file << "I,D,U";
             break;
+        case Algorithm::ParallelPushRelabel:
+            output_file << "threads,pushes,relabels,global_relabels,speedup_ek,speedup_fp";
+            break;
+        case Algorithm::BoykovKolmogorov:
+            output_file << "avg_s,avg_t,orphans,adoptions,speedup_ek,speedup_fp";
+            break;
+        case Algorithm::Pseudoflow:
+            output_file << "merges,splits,relabels,source_side";
+            break;
         default:
             throw std::runtime_error("Unknown algorithm in log_stats_header");
     }
+
+    // One column per (phase, event) pair, e.g. search_cycles
+    if (with_perf) {
+        for (int p = 0; p < NUM_PHASES; ++p) {
+            for (int e = 0; e < NUM_PERF_EVENTS; ++e) {
+                output_file << "," << Perf::phase_name(static_cast<Phase>(p)) << "_"
+                            << Perf::event_name(static_cast<PerfEvent>(e));
+            }
+        }
+    }
+
+    // One column per (phase, quantity) pair, e.g. solve_alloc_bytes
+    if (with_memory) {
+        for (int p = 0; p < NUM_MEMORY_PHASES; ++p) {
+            for (int e = 0; e < NUM_MEMORY_EVENTS; ++e) {
+                output_file << "," << Memory::phase_name(static_cast<MemoryPhase>(p)) << "_"
+                            << Memory::event_name(static_cast<MemoryEvent>(e));
+            }
+        }
+    }
     output_file << std::endl;
 }
 
 void log_instance_stats(const GraphMetrics &stats, const Algorithm &algo,
-                        std::ofstream &output_file)
+                        std::ofstream &output_file, bool with_perf, bool with_memory)
 {
     output_file << std::fixed << std::setprecision(12);
 
@@ -33,7 +64,8 @@ void log_instance_stats(const GraphMetrics &stats, const Algorithm &algo,
                 << stats.nor_time << "," << stats.avg_l << ",";
 
     switch (algo) {
-        case Algorithm::EdmondsKarp: {
+        case Algorithm::EdmondsKarp:
+        case Algorithm::ParallelEdmondsKarp: {
             output_file << stats.C << "," << stats.avg_crit << "," << stats.avg_s << ","
                         << stats.avg_t;
             break;
@@ -45,10 +77,41 @@ void log_instance_stats(const GraphMetrics &stats, const Algorithm &algo,
         case Algorithm::FattestPath:
             output_file << stats.I << "," << stats.D << "," << stats.U;
             break;
+        case Algorithm::ParallelPushRelabel:
+            output_file << stats.threads << "," << stats.pushes << "," << stats.relabels << ","
+                        << stats.global_relabels << "," << stats.speedup_ek << ","
+                        << stats.speedup_fp;
+            break;
+        case Algorithm::BoykovKolmogorov:
+            output_file << stats.avg_s << "," << stats.avg_t << "," << stats.orphans << ","
+                        << stats.adoptions << "," << stats.speedup_ek << "," << stats.speedup_fp;
+            break;
+        case Algorithm::Pseudoflow:
+            output_file << stats.merges << "," << stats.splits << "," << stats.relabels << ","
+                        << stats.source_side;
+            break;
         default:
             throw std::runtime_error("Unknown algorithm in log_instance_stats");
     }
 
+    if (with_perf) {
+        output_file << std::setprecision(1);
+        for (const auto &phase : stats.perf.values) {
+            for (double value : phase) {
+                output_file << "," << value;
+            }
+        }
+    }
+
+    if (with_memory) {
+        output_file << std::setprecision(1);
+        for (const auto &phase : stats.memory.values) {
+            for (double value : phase) {
+                output_file << "," << value;
+            }
+        }
+    }
+
     output_file << std::endl;
 }
 
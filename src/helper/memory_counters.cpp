@@ -0,0 +1,166 @@
+#include "memory_counters.hpp"
+
+#include <sys/resource.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+
+namespace
+{
+
+// Global allocation counters, only updated while a MemoryCounters is alive so
+// that other runs pay a single relaxed load per allocation
+std::atomic<bool> counting{false};
+std::atomic<uint64_t> allocated_bytes{0};
+std::atomic<uint64_t> allocation_count{0};
+
+void count_allocation(std::size_t bytes)
+{
+    if (counting.load(std::memory_order_relaxed)) {
+        allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// Resets the peak resident set size of the process to its current size
+void reset_peak_rss()
+{
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    clear_refs << "5";
+}
+
+// Peak resident set size of the process in KiB
+long peak_rss_kib()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+}  // namespace
+
+// Replaced global allocation functions. The array and nothrow forms forward to
+// these in libstdc++, so they are counted too.
+void* operator new(std::size_t bytes)
+{
+    count_allocation(bytes);
+    if (bytes == 0)
+        bytes = 1;
+    while (true) {
+        if (void* block = std::malloc(bytes))
+            return block;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler)
+            throw std::bad_alloc();
+        handler();
+    }
+}
+
+void* operator new(std::size_t bytes, std::align_val_t alignment)
+{
+    count_allocation(bytes);
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    const std::size_t rounded = (bytes + align - 1) / align * align;
+    if (void* block = std::aligned_alloc(align, rounded == 0 ? align : rounded))
+        return block;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* block) noexcept { std::free(block); }
+
+void operator delete(void* block, std::size_t) noexcept { std::free(block); }
+
+void operator delete(void* block, std::align_val_t) noexcept { std::free(block); }
+
+void operator delete(void* block, std::size_t, std::align_val_t) noexcept { std::free(block); }
+
+void MemoryStats::increment(const MemoryStats& other)
+{
+    for (int p = 0; p < NUM_MEMORY_PHASES; ++p) {
+        for (int e = 0; e < NUM_MEMORY_EVENTS; ++e) {
+            values[p][e] += other.values[p][e];
+        }
+    }
+}
+
+void MemoryStats::average(int num_runs)
+{
+    if (num_runs > 0) {
+        for (auto& phase : values) {
+            for (double& value : phase) {
+                value /= num_runs;
+            }
+        }
+    }
+}
+
+double MemoryStats::get(MemoryPhase phase, MemoryEvent event) const
+{
+    return values[static_cast<int>(phase)][static_cast<int>(event)];
+}
+
+MemoryCounters::MemoryCounters() : begin_bytes(0), begin_allocations(0)
+{
+    counting.store(true, std::memory_order_relaxed);
+}
+
+MemoryCounters::~MemoryCounters() { counting.store(false, std::memory_order_relaxed); }
+
+void MemoryCounters::start()
+{
+    reset_peak_rss();
+    begin_bytes = allocated_bytes.load(std::memory_order_relaxed);
+    begin_allocations = allocation_count.load(std::memory_order_relaxed);
+}
+
+void MemoryCounters::stop(MemoryPhase phase)
+{
+    auto& values = stats.values[static_cast<int>(phase)];
+    values[static_cast<int>(MemoryEvent::AllocatedBytes)] +=
+        allocated_bytes.load(std::memory_order_relaxed) - begin_bytes;
+    values[static_cast<int>(MemoryEvent::Allocations)] +=
+        allocation_count.load(std::memory_order_relaxed) - begin_allocations;
+    values[static_cast<int>(MemoryEvent::PeakRss)] += peak_rss_kib();
+}
+
+void MemoryCounters::reset() { stats = MemoryStats{}; }
+
+const MemoryStats& MemoryCounters::get_stats() const { return stats; }
+
+namespace Memory
+{
+
+std::string phase_name(MemoryPhase phase)
+{
+    switch (phase) {
+        case MemoryPhase::Parse:
+            return "parse";
+        case MemoryPhase::Copy:
+            return "copy";
+        case MemoryPhase::Solve:
+            return "solve";
+        case MemoryPhase::Metrics:
+            return "metrics";
+        default:
+            throw std::invalid_argument("Unknown memory phase");
+    }
+}
+
+std::string event_name(MemoryEvent event)
+{
+    switch (event) {
+        case MemoryEvent::AllocatedBytes:
+            return "alloc_bytes";
+        case MemoryEvent::Allocations:
+            return "allocs";
+        case MemoryEvent::PeakRss:
+            return "peak_rss_kib";
+        default:
+            throw std::invalid_argument("Unknown memory event");
+    }
+}
+
+}  // namespace Memory
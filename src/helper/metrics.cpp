@@ -6,37 +6,64 @@ namespace Metrics
 long long compute_max_iterations(Graph& graph, int source, Algorithm algo, int upper_limit = 0)
 {
     switch (algo) {
-        case Algorithm::EdmondsKarp: {
+        case Algorithm::EdmondsKarp:
+        case Algorithm::ParallelEdmondsKarp: {
             const int n = graph.get_total_vertices();
             const int m = graph.get_total_arcs();
             return std::max(
                 1LL, (static_cast<long long>(n) * m) / 2);  // Use long long for safe multiplication
         }
-        case Algorithm::RandomizedDFS: {
+        case Algorithm::RandomizedDFS:
+        case Algorithm::BoykovKolmogorov: {
             return std::max(1, upper_limit);
         }
         case Algorithm::FattestPath: {
             const int m = graph.get_total_arcs();
             return std::max(1LL, static_cast<long long>(m * std::log2(upper_limit)));
         }
+        case Algorithm::Pseudoflow: {
+            // Each merge is bounded by the O(nm) label increments and splits
+            const long long n = graph.get_total_vertices();
+            const long long m = graph.get_total_arcs();
+            return std::max(1LL, n * m);
+        }
+        case Algorithm::ParallelPushRelabel: {
+            // Generic push-relabel bound of O(n²m) pushes
+            const double n = graph.get_total_vertices();
+            const double m = graph.get_total_arcs();
+            return std::max(1LL, static_cast<long long>(std::min(4.0 * n * n * m, 9e18)));
+        }
         default:
             return 1;
     }
 }
 
-double compute_average(const std::vector<double>& elements, double total)
+TraceAverages compute_trace_averages(const IterationTrace& trace, int n, int m)
 {
-    if (total == 0.0)
-        return 0.0;
+    const auto& records = trace.get_records();
+    TraceAverages sums = {0};
+    if (records.empty())
+        return sums;
 
-    double sum = 0.0;
-    for (double e : elements) {
+    auto check_fraction = [](double e) {
         if (e < 0.0 || e > 1.0) {
             throw std::runtime_error("Average input value out of expected range [0,1]");
         }
-        sum += e;
+        return e;
+    };
+
+    for (const IterationRecord& rec : records) {
+        sums.avg_l += rec.path_length;
+        sums.avg_s += check_fraction(static_cast<double>(rec.visited_verts) / n);
+        sums.avg_t += check_fraction(static_cast<double>(rec.visited_arcs) / m);
+        sums.I += check_fraction(static_cast<double>(rec.inserts) / n);
+        sums.D += check_fraction(static_cast<double>(rec.deletemaxes) / n);
+        sums.U += check_fraction(static_cast<double>(rec.updates) / m);
     }
-    return sum / total;
+
+    const double total = records.size();
+    return TraceAverages{sums.avg_l / total, sums.avg_s / total, sums.avg_t / total,
+                         sums.I / total,     sums.D / total,     sums.U / total};
 }
 
 CriticalArcStats compute_critical_arc_stats(Graph& graph)
@@ -89,36 +116,58 @@ GraphMetrics compute_graph_metrics(Graph& graph, const Algorithm& algo, const Fo
     const double time_ms = result.duration_ms;
     const double nor_time = time_ms / static_cast<double>(static_cast<long long>(n) * m * (n + m));
 
-    const double avg_l = std::accumulate(result.stats.path_lengths_per_iter.begin(),
-                                         result.stats.path_lengths_per_iter.end(), 0.0) /
-                         result.iterations;
+    const TraceAverages averages = compute_trace_averages(result.stats, n, m);
 
-    GraphMetrics metrics;
+    GraphMetrics metrics = {0};
     metrics.n = n;
     metrics.m = m;
     metrics.r = r;
     metrics.time_ms = time_ms;
     metrics.nor_time = nor_time;
-    metrics.avg_l = avg_l;
+    metrics.avg_l = averages.avg_l;
 
     switch (algo) {
-        case Algorithm::EdmondsKarp: {
+        case Algorithm::EdmondsKarp:
+        case Algorithm::ParallelEdmondsKarp: {
             const CriticalArcStats crit_stats = compute_critical_arc_stats(graph);
             metrics.C = crit_stats.C;
             metrics.avg_crit = crit_stats.r_bar;
-            metrics.avg_s = compute_average(result.stats.s_per_iter, result.iterations);
-            metrics.avg_t = compute_average(result.stats.t_per_iter, result.iterations);
+            metrics.avg_s = averages.avg_s;
+            metrics.avg_t = averages.avg_t;
             break;
         }
         case Algorithm::RandomizedDFS: {
-            metrics.avg_s = compute_average(result.stats.s_per_iter, result.iterations);
-            metrics.avg_t = compute_average(result.stats.t_per_iter, result.iterations);
+            metrics.avg_s = averages.avg_s;
+            metrics.avg_t = averages.avg_t;
             break;
         }
         case Algorithm::FattestPath: {
-            metrics.I = compute_average(result.stats.inserts_per_iter, result.iterations);
-            metrics.D = compute_average(result.stats.deletemaxes_per_iter, result.iterations);
-            metrics.U = compute_average(result.stats.updates_per_iter, result.iterations);
+            metrics.I = averages.I;
+            metrics.D = averages.D;
+            metrics.U = averages.U;
+            break;
+        }
+        case Algorithm::ParallelPushRelabel: {
+            metrics.threads = result.push_relabel.threads;
+            metrics.pushes = result.push_relabel.pushes;
+            metrics.relabels = result.push_relabel.relabels;
+            metrics.global_relabels = result.push_relabel.global_relabels;
+            break;
+        }
+        case Algorithm::BoykovKolmogorov: {
+            metrics.avg_s = averages.avg_s;
+            metrics.avg_t = averages.avg_t;
+            metrics.orphans = result.boykov_kolmogorov.orphans;
+            metrics.adoptions = result.boykov_kolmogorov.adoptions;
+            break;
+        }
+        case Algorithm::Pseudoflow: {
+            metrics.merges = result.pseudoflow.merges;
+            metrics.splits = result.pseudoflow.splits;
+            metrics.relabels = result.pseudoflow.relabels;
+            metrics.source_side =
+                std::count(result.source_side.begin(), result.source_side.end(), 1) /
+                static_cast<double>(n);
             break;
         }
         default:
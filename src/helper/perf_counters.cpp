@@ -0,0 +1,173 @@
+#include "perf_counters.hpp"
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+
+// Opens a single user-space counter for the calling thread and the threads it
+// creates afterwards (the OpenMP workers), whose counts are added to its own
+int open_counter(uint32_t type, uint64_t config, int group_fd)
+{
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = (group_fd == -1) ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.inherit = 1;  // Older kernels refuse it with PERF_FORMAT_GROUP: read each counter
+
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+
+// (type, config) pair of each PerfEvent, in enum order
+const std::array<std::pair<uint32_t, uint64_t>, NUM_PERF_EVENTS> EVENT_CONFIGS = {{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+}};
+
+}  // namespace
+
+void PerfStats::increment(const PerfStats &other)
+{
+    for (int p = 0; p < NUM_PHASES; ++p) {
+        for (int e = 0; e < NUM_PERF_EVENTS; ++e) {
+            values[p][e] += other.values[p][e];
+        }
+    }
+}
+
+void PerfStats::average(int num_runs)
+{
+    if (num_runs > 0) {
+        for (auto &phase : values) {
+            for (double &value : phase) {
+                value /= num_runs;
+            }
+        }
+    }
+}
+
+double PerfStats::get(Phase phase, PerfEvent event) const
+{
+    return values[static_cast<int>(phase)][static_cast<int>(event)];
+}
+
+PerfCounters::PerfCounters() : leader_fd(-1), begin{}
+{
+    fds.fill(-1);
+
+    // The cycle counter leads the group; the remaining events are optional since
+    // some (virtualized) CPUs do not expose every cache event
+    for (int e = 0; e < NUM_PERF_EVENTS; ++e) {
+        int fd = open_counter(EVENT_CONFIGS[e].first, EVENT_CONFIGS[e].second, leader_fd);
+        if (fd == -1) {
+            if (e == 0)
+                return;
+            continue;
+        }
+        if (e == 0)
+            leader_fd = fd;
+        fds[e] = fd;
+    }
+
+    ioctl(leader_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+PerfCounters::~PerfCounters()
+{
+    for (int fd : fds) {
+        if (fd != -1)
+            close(fd);
+    }
+}
+
+bool PerfCounters::is_available() const { return leader_fd != -1; }
+
+void PerfCounters::start()
+{
+    if (is_available())
+        read_group(begin);
+}
+
+void PerfCounters::stop(Phase phase)
+{
+    std::array<uint64_t, NUM_PERF_EVENTS> end;
+    if (!is_available() || !read_group(end))
+        return;
+
+    auto &values = stats.values[static_cast<int>(phase)];
+    for (int e = 0; e < NUM_PERF_EVENTS; ++e) {
+        values[e] += static_cast<double>(end[e] - begin[e]);
+    }
+}
+
+void PerfCounters::reset() { stats = PerfStats{}; }
+
+const PerfStats &PerfCounters::get_stats() const { return stats; }
+
+bool PerfCounters::read_group(std::array<uint64_t, NUM_PERF_EVENTS> &out) const
+{
+    // Inherited counters cannot be read as a group: each read returns the sum
+    // over the calling thread and its children
+    for (int e = 0; e < NUM_PERF_EVENTS; ++e) {
+        out[e] = 0;
+        if (fds[e] != -1 && read(fds[e], &out[e], sizeof(uint64_t)) != sizeof(uint64_t))
+            return false;
+    }
+    return true;
+}
+
+namespace Perf
+{
+
+std::string phase_name(Phase phase)
+{
+    switch (phase) {
+        case Phase::Load:
+            return "load";
+        case Phase::Copy:
+            return "copy";
+        case Phase::Search:
+            return "search";
+        case Phase::Augment:
+            return "augment";
+        case Phase::Metrics:
+            return "metrics";
+        default:
+            throw std::invalid_argument("Unknown phase");
+    }
+}
+
+std::string event_name(PerfEvent event)
+{
+    switch (event) {
+        case PerfEvent::Cycles:
+            return "cycles";
+        case PerfEvent::Instructions:
+            return "instructions";
+        case PerfEvent::L1DMisses:
+            return "l1d_misses";
+        case PerfEvent::LLCMisses:
+            return "llc_misses";
+        case PerfEvent::BranchMisses:
+            return "branch_misses";
+        default:
+            throw std::invalid_argument("Unknown perf event");
+    }
+}
+
+}  // namespace Perf
@@ -1,9 +1,39 @@
+#include <sys/resource.h>
+
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
 
 #include "ford_fulk.hpp"
+#include "gomory_hu.hpp"
 #include "logger.hpp"
 
+// Optional flags accepted anywhere after the program name
+struct SolverOptions {
+    bool perf = false;        // --perf: record hardware counters per phase (Benchmark Mode)
+    std::string trace_path;   // --trace=<file>: dump the iteration trace (Single Run Mode)
+    bool timing = false;      // --timing: also print iterations and solve time (Single Run Mode)
+    bool preprocess = false;  // --preprocess: solve the pruned and contracted graph
+    bool memory = false;      // --memory: report adjacency slab and memory use per phase
+    bool compressed = false;  // --compressed: solve on varint-compressed adjacency lists
+    std::string serve_path;   // --serve=<file>: answer requests on a resident graph
+    std::string tree_path;    // --gomory-hu=<file>: write the cut tree of the stdin graph
+    std::string query_path;   // --cut-tree=<file>: answer min cut queries from a cut tree
+    std::string batch_path;   // --batch=<file>: solve every (s, t) pair listed in the file
+    uint64_t seed = DEFAULT_SEED;   // --seed=<n>: seed of the randomized searches
+    int target = NO_TARGET;         // --target=<n>: only decide whether the flow reaches n
+    std::string checkpoint_path;    // --checkpoint=<file>: save the residual graph periodically
+    int checkpoint_every = 0;       // --checkpoint-every=<n>: augmentations between checkpoints
+    double checkpoint_seconds = 0;  // --checkpoint-seconds=<s>: seconds between checkpoints
+    bool resume = false;            // --resume: continue from the checkpoint file
+
+    // --reorder=<bfs|rcm>: renumber vertices before solving
+    VertexOrder order = VertexOrder::Input;
+};
+
 int display_usage_tutorial(char const* program_name)
 {
     std::cerr << "Usage:\n";
@@ -12,17 +42,92 @@ int display_usage_tutorial(char const* program_name)
     std::cerr << "  2. Benchmark Mode (reads graphs from folder):\n";
     std::cerr << "     " << program_name
               << " <algorithm_index> <graphs_folder_path> <output_file_name>\n\n";
+    std::cerr << "  3. Service Mode (loads one graph, answers requests from stdin):\n";
+    std::cerr << "     " << program_name << " <algorithm_index> --serve=<graph_file>\n\n";
+    std::cerr << "  4. Cut Tree Mode (builds a Gomory-Hu tree, then answers queries from it):\n";
+    std::cerr << "     " << program_name << " <algorithm_index> --gomory-hu=<tree_file> < graph\n";
+    std::cerr << "     " << program_name << " --cut-tree=<tree_file> < pairs\n\n";
 
     std::cerr << "Arguments:\n";
     std::cerr << "  <algorithm_index>        Required. Choose one of the following:\n";
     std::cerr << "                           0 - Edmonds-Karp (BFS)\n";
     std::cerr << "                           1 - Randomized DFS\n";
     std::cerr << "                           2 - Fattest Path (Modified Dijkstra)\n";
+    std::cerr << "                           3 - Parallel Edmonds-Karp (OpenMP BFS)\n";
+    std::cerr << "                           4 - Parallel Push-Relabel (OpenMP)\n";
+    std::cerr << "                           5 - Boykov-Kolmogorov (search tree reuse)\n";
+    std::cerr << "                           6 - Pseudoflow (Hochbaum, highest label)\n";
     std::cerr << "  <graphs_folder_path>     Required for Benchmark Mode. Path to folder "
                  "containing graph files.\n";
     std::cerr << "  <output_file_name>       Required for Benchmark Mode. Name of the output file "
                  "to save benchmark results (e.g., results.csv).\n\n";
 
+    std::cerr << "Options:\n";
+    std::cerr << "  --perf                   Benchmark Mode only. Append hardware counters "
+                 "(cycles, instructions,\n"
+                 "                           L1/LLC misses, branch misses) per solver phase to "
+                 "the CSV.\n";
+    std::cerr << "  --trace=<file>           Single Run Mode only. Write the per-iteration trace "
+                 "to a binary file.\n";
+    std::cerr << "  --timing                 Single Run Mode only. Print \"<max_flow> <iterations> "
+                 "<solve_time_µs>\".\n";
+    std::cerr << "  --preprocess             Prune vertices that carry no flow and contract "
+                 "degree-2 chains\n"
+                 "                           before solving. Reports the reduction on stderr.\n";
+    std::cerr << "  --reorder=<bfs|rcm>      Renumber vertices in BFS order from the source or "
+                 "Reverse\n"
+                 "                           Cuthill-McKee order before solving.\n";
+    std::cerr << "  --memory                 Report the adjacency slab size and the peak resident "
+                 "memory after\n"
+                 "                           loading each graph on stderr. In Benchmark Mode, "
+                 "also append the\n"
+                 "                           bytes allocated, allocations and peak RSS of the "
+                 "parse, copy, solve\n"
+                 "                           and metrics phases to the CSV.\n";
+    std::cerr << "  --compressed             Single Run Mode only, algorithms 0 and 2. Keep the "
+                 "graph as sorted,\n"
+                 "                           gap-encoded neighbor lists (about 1-2 bytes per arc "
+                 "instead of 16)\n"
+                 "                           plus capacity arrays. With --memory, reports both "
+                 "footprints.\n";
+    std::cerr << "  --serve=<file>           Load <file> once and answer one request per stdin "
+                 "line (vertices\n"
+                 "                           are 1-based, source and sink default to the "
+                 "graph's own):\n"
+                 "                             flow [<s> <t>]     -> <max_flow>\n"
+                 "                             cut [<s> <t>]      -> <max_flow> <k> <source side "
+                 "vertices...>\n"
+                 "                             cap <u> <v> <c>    -> ok (sets the capacity of "
+                 "arc u->v)\n"
+                 "                             quit\n"
+                 "                           Failed requests answer \"error: <reason>\".\n";
+    std::cerr << "  --batch=<file>           Single Run Mode only. Solve every \"<s> <t>\" pair "
+                 "(1-based) listed in\n"
+                 "                           <file> on the stdin graph, in parallel, printing one "
+                 "result per pair.\n";
+    std::cerr << "  --gomory-hu=<file>       Write the cut tree of the undirected view of the stdin "
+                 "graph to\n"
+                 "                           <file> (n - 1 max-flows on per-thread copies) and "
+                 "print the global\n"
+                 "                           minimum cut.\n";
+    std::cerr << "  --cut-tree=<file>        Read \"<u> <v>\" pairs (1-based) from stdin and print "
+                 "their minimum\n"
+                 "                           cut from a tree written by --gomory-hu.\n";
+    std::cerr << "  --target=<n>             Single Run Mode only. Print \"yes\" or \"no\": whether "
+                 "the max flow\n"
+                 "                           reaches <n>, stopping as soon as that is known.\n";
+    std::cerr << "  --checkpoint=<file>      Single Run Mode only, algorithms 0-3. Save the "
+                 "residual capacities and\n"
+                 "                           flow to <file> in the background every "
+                 "--checkpoint-every=<n>\n"
+                 "                           augmentations and/or --checkpoint-seconds=<s> seconds "
+                 "(default 60 s).\n";
+    std::cerr << "  --resume                 Continue from the --checkpoint file, if it was taken "
+                 "on the same graph.\n";
+    std::cerr << "  --seed=<n>               Seed the randomized searches (default "
+              << DEFAULT_SEED << "). Benchmark run i uses\n"
+                 "                           <n> + i, so runs are reproducible.\n\n";
+
     std::cerr << "Examples:\n";
     std::cerr << "  " << program_name << " 0\n";
     std::cerr << "      # Run Edmonds-Karp on a single graph from stdin\n";
@@ -32,40 +137,421 @@ int display_usage_tutorial(char const* program_name)
     return -1;
 }
 
-int single_run_mode(Algorithm algo)
+// Prints the size reduction achieved by preprocessing
+void report_reduction(const ReductionStats& stats, const std::string& name)
+{
+    std::cerr << "Preprocessing" << (name.empty() ? "" : " " + name) << ": "
+              << stats.original_vertices << " -> " << stats.vertices << " vertices, "
+              << stats.original_arcs << " -> " << stats.arcs << " arcs (" << stats.pruned_vertices
+              << " pruned, " << stats.contracted_vertices << " contracted), ratio "
+              << stats.ratio() << "\n";
+}
+
+// Prints the size of the adjacency slab of a freshly loaded graph and the
+// process's peak resident memory so far
+void report_memory(const Graph& graph, const std::string& name)
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    std::cerr << "Memory" << (name.empty() ? "" : " " + name) << ": ";
+    if (const Arena* arena = graph.get_edge_arena()) {
+        std::cerr << "adjacency slab " << arena->get_reserved_bytes() / 1024 << " KiB ("
+                  << arena->get_used_bytes() / 1024 << " KiB used, " << arena->get_chunk_count()
+                  << " chunk" << (arena->get_chunk_count() == 1 ? "" : "s") << "), ";
+    }
+    std::cerr << "peak RSS " << usage.ru_maxrss << " KiB\n";
+}
+
+// Creates the checkpointer asked for by the options, resuming from its file if
+// requested, or nullptr if no checkpoint file was given
+template <typename GraphType>
+std::unique_ptr<Checkpointer> open_checkpoint(GraphType& graph, const SolverOptions& options)
+{
+    if (options.checkpoint_path.empty())
+        return nullptr;
+    // Every minute unless an interval was given
+    double seconds = options.checkpoint_seconds;
+    if (options.checkpoint_every == 0 && seconds == 0)
+        seconds = 60;
+    auto checkpoint =
+        std::make_unique<Checkpointer>(options.checkpoint_path, options.checkpoint_every, seconds);
+    if (options.resume) {
+        if (checkpoint->resume(graph)) {
+            std::cerr << "Checkpoint: resumed at flow " << checkpoint->get_resumed().max_flow
+                      << " after " << checkpoint->get_resumed().iterations << " iterations\n";
+        } else {
+            std::cerr << "Checkpoint: no usable checkpoint in " << options.checkpoint_path
+                      << ", starting over\n";
+        }
+    }
+    return checkpoint;
+}
+
+// Waits for the last checkpoint and reports how many were written
+void close_checkpoint(Checkpointer* checkpoint)
+{
+    if (!checkpoint)
+        return;
+    checkpoint->wait();
+    std::cerr << "Checkpoint: " << checkpoint->get_written() << " written";
+    if (checkpoint->get_failed() > 0)
+        std::cerr << ", " << checkpoint->get_failed() << " failed";
+    std::cerr << "\n";
+}
+
+// Solves the stdin graph on compressed adjacency lists, printing the same line
+// as single_run_mode
+int compressed_run_mode(Algorithm algo, const SolverOptions& options)
+{
+    if (algo != Algorithm::EdmondsKarp && algo != Algorithm::FattestPath) {
+        std::cerr << "Error: --compressed needs Edmonds-Karp (0) or Fattest Path (2)\n";
+        return -1;
+    }
+    std::unique_ptr<CompressedGraph> loaded;
+    try {
+        loaded = std::make_unique<CompressedGraph>(std::cin);
+    } catch (const std::invalid_argument& error) {
+        std::cerr << "Error: " << error.what() << "\n";
+        return -1;
+    }
+    CompressedGraph& graph = *loaded;
+    if (options.memory) {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        const size_t compressed = graph.get_topology_bytes() + graph.get_capacity_bytes();
+        std::cerr << "Memory: compressed topology " << graph.get_topology_bytes() / 1024
+                  << " KiB, capacities " << graph.get_capacity_bytes() / 1024 << " KiB ("
+                  << graph.get_uncompressed_bytes() / 1024 << " KiB uncompressed, ratio "
+                  << static_cast<double>(graph.get_uncompressed_bytes()) / compressed
+                  << "), peak RSS " << usage.ru_maxrss << " KiB\n";
+    }
+
+    bool should_trace = !options.trace_path.empty();
+    std::unique_ptr<Checkpointer> checkpoint = open_checkpoint(graph, options);
+    FordResult result = ford_fulkerson(graph, graph.get_source(), graph.get_sink(), algo,
+                                       should_trace, checkpoint.get());
+    close_checkpoint(checkpoint.get());
+
+    if (should_trace && !result.stats.dump(options.trace_path, graph.get_total_vertices(),
+                                           graph.get_total_arcs())) {
+        std::cerr << "Error: could not write trace to " << options.trace_path << "\n";
+        return -1;
+    }
+
+    std::cout << result.max_flow;
+    if (options.timing) {
+        std::cout << " " << result.iterations << " " << result.duration_ms;
+    }
+    std::cout << std::endl;
+    return 0;
+}
+
+// Whether a graph with several sources or sinks can be solved with the given
+// options, reporting why not on stderr
+bool check_terminal_sets(const Graph& graph, Algorithm algo, const SolverOptions& options,
+                         const std::string& name)
+{
+    if (!graph.has_terminal_sets())
+        return true;
+    if (supports_terminal_sets(algo) && !options.preprocess)
+        return true;
+    std::cerr << "Error" << (name.empty() ? "" : " " + name)
+              << ": graphs with several sources or sinks need an augmenting path algorithm (0-3) "
+                 "and no --preprocess\n";
+    return false;
+}
+
+int single_run_mode(Algorithm algo, const SolverOptions& options)
+{
+    Graph graph(std::cin);
+    if (options.memory)
+        report_memory(graph, "");
+    if (!check_terminal_sets(graph, algo, options, ""))
+        return -1;
+    if (options.order != VertexOrder::Input)
+        graph.reorder_vertices(options.order);
+
+    // Solve the reduced graph and write its flow back onto the input graph
+    std::unique_ptr<ReducedGraph> reduced;
+    Graph* target = &graph;
+    if (options.preprocess) {
+        reduced = std::make_unique<ReducedGraph>(graph);
+        report_reduction(reduced->get_reduction_stats(), "");
+        target = reduced.get();
+    }
+
+    // Multi-terminal graphs are solved between their whole terminal sets
+    const bool terminal_sets = target->has_terminal_sets();
+    const int source = terminal_sets ? ALL_TERMINALS : target->get_source();
+    const int sink = terminal_sets ? ALL_TERMINALS : target->get_sink();
+
+    // Checkpointed solves always run the augmenting loop, which saves them
+    bool should_trace = !options.trace_path.empty();
+    const bool decision = options.target != NO_TARGET;
+    std::unique_ptr<Checkpointer> checkpoint = open_checkpoint(*target, options);
+    FordResult result =
+        checkpoint ? ford_fulkerson(*target, source, sink, algo, should_trace, nullptr,
+                                    options.seed, options.target, checkpoint.get())
+        : decision ? solve_max_flow_until(*target, source, sink, algo, options.target,
+                                          should_trace, options.seed)
+                   : solve_max_flow(*target, source, sink, algo, should_trace, nullptr,
+                                    options.seed);
+    close_checkpoint(checkpoint.get());
+    if (reduced)
+        reduced->map_flow_back(graph);
+
+    if (should_trace && !result.stats.dump(options.trace_path, target->get_total_vertices(),
+                                           target->get_total_arcs())) {
+        std::cerr << "Error: could not write trace to " << options.trace_path << "\n";
+        return -1;
+    }
+
+    if (decision)
+        std::cout << (result.max_flow >= options.target ? "yes" : "no");
+    else
+        std::cout << result.max_flow;
+    if (options.timing) {
+        std::cout << " " << result.iterations << " " << result.duration_ms;
+    }
+    std::cout << std::endl;
+    return 0;
+}
+
+// Reads the optional 1-based source and sink of a flow or cut request, which
+// default to the graph's own. Returns false if they are malformed or equal.
+bool parse_terminals(std::istringstream& request, const Graph& graph, int& source, int& sink)
+{
+    source = graph.get_source();
+    sink = graph.get_sink();
+    int s, t;
+    if (request >> s) {
+        if (!(request >> t))
+            return false;
+        source = s - 1;
+        sink = t - 1;
+    }
+    const int n = graph.get_total_vertices();
+    return source >= 0 && source < n && sink >= 0 && sink < n && source != sink;
+}
+
+int service_mode(Algorithm algo, const SolverOptions& options)
+{
+    std::ifstream input(options.serve_path);
+    if (!input.is_open()) {
+        std::cerr << "Error: could not open " << options.serve_path << "\n";
+        return -1;
+    }
+    Graph graph(input);
+    if (options.memory)
+        report_memory(graph, "");
+    const int n = graph.get_total_vertices();
+
+    // Every solve starts from the saved capacities, so the topology is parsed
+    // once and a request only pays for the reset and the solve
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        std::istringstream request(line);
+        std::string command;
+        if (!(request >> command))
+            continue;
+
+        if (command == "quit") {
+            break;
+        } else if (command == "flow" || command == "cut") {
+            int source, sink;
+            if (!parse_terminals(request, graph, source, sink)) {
+                std::cout << "error: expected two distinct vertices in 1.." << n << std::endl;
+                continue;
+            }
+            graph.reset_residual();
+            FordResult result =
+                solve_max_flow(graph, source, sink, algo, false, nullptr, options.seed);
+
+            std::cout << result.max_flow;
+            if (command == "cut") {
+                std::vector<char> side = min_cut_source_side(graph, source, result);
+                std::cout << " " << std::count(side.begin(), side.end(), 1);
+                for (int v = 0; v < n; ++v) {
+                    if (side[v])
+                        std::cout << " " << v + 1;
+                }
+            } else if (options.timing) {
+                std::cout << " " << result.iterations << " " << result.duration_ms;
+            }
+            std::cout << std::endl;
+        } else if (command == "cap") {
+            int tail, head, capacity;
+            if (!(request >> tail >> head >> capacity) || tail < 1 || tail > n || head < 1 ||
+                head > n || capacity < 0) {
+                std::cout << "error: expected <u> <v> <capacity> with vertices in 1.." << n
+                          << std::endl;
+            } else if (!graph.set_capacity(tail - 1, head - 1, capacity)) {
+                std::cout << "error: no arc between " << tail << " and " << head << std::endl;
+            } else {
+                graph.reset_residual();
+                graph.detect_unit_bipartite();
+                std::cout << "ok" << std::endl;
+            }
+        } else {
+            std::cout << "error: unknown request " << command << std::endl;
+        }
+    }
+    return 0;
+}
+
+int batch_mode(Algorithm algo, const SolverOptions& options)
+{
+    std::ifstream input(options.batch_path);
+    if (!input.is_open()) {
+        std::cerr << "Error: could not open " << options.batch_path << "\n";
+        return -1;
+    }
+    Graph graph(std::cin);
+    const int n = graph.get_total_vertices();
+
+    // Malformed pairs keep their line in the output as an error
+    std::vector<std::pair<int, int>> pairs;
+    std::vector<int> pair_of_line;
+    std::string line;
+    while (std::getline(input, line)) {
+        std::istringstream request(line);
+        int s, t;
+        if (!(request >> s))
+            continue;
+        if (!(request >> t) || s < 1 || s > n || t < 1 || t > n || s == t) {
+            pair_of_line.push_back(-1);
+            continue;
+        }
+        pair_of_line.push_back(pairs.size());
+        pairs.emplace_back(s - 1, t - 1);
+    }
+
+    std::vector<FordResult> results = solve_max_flow_batch(graph, pairs, algo, options.seed);
+    for (int index : pair_of_line) {
+        if (index < 0) {
+            std::cout << "error: expected two distinct vertices in 1.." << n << "\n";
+            continue;
+        }
+        std::cout << results[index].max_flow;
+        if (options.timing) {
+            std::cout << " " << results[index].iterations << " " << results[index].duration_ms;
+        }
+        std::cout << "\n";
+    }
+    return 0;
+}
+
+int gomory_hu_mode(Algorithm algo, const SolverOptions& options)
 {
     Graph graph(std::cin);
-    FordResult result = ford_fulkerson(graph, graph.get_source(), graph.get_sink(), algo, false);
+    GomoryHuTree tree = gomory_hu_tree(graph, algo, options.seed);
+    if (!tree.dump(options.tree_path)) {
+        std::cerr << "Error: could not write cut tree to " << options.tree_path << "\n";
+        return -1;
+    }
+    std::cerr << "Gomory-Hu: " << tree.stats.flows << " max-flows on " << tree.stats.threads
+              << " threads (" << tree.stats.misses << " stale cuts solved again)\n";
+
+    // The lightest tree edge is the global minimum cut
+    int global_cut = std::numeric_limits<int>::max();
+    for (size_t v = 1; v < tree.weight.size(); ++v) global_cut = std::min(global_cut, tree.weight[v]);
+    std::cout << (tree.weight.size() > 1 ? global_cut : 0) << std::endl;
+    return 0;
+}
 
-    std::cout << result.max_flow << std::endl;
+int cut_tree_mode(const SolverOptions& options)
+{
+    GomoryHuTree tree;
+    if (!tree.load(options.query_path)) {
+        std::cerr << "Error: could not read cut tree from " << options.query_path << "\n";
+        return -1;
+    }
+    const int n = tree.parent.size();
+
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        std::istringstream request(line);
+        int u, v;
+        if (!(request >> u))
+            continue;
+        if (!(request >> v) || u < 1 || u > n || v < 1 || v > n || u == v) {
+            std::cout << "error: expected two distinct vertices in 1.." << n << std::endl;
+            continue;
+        }
+        std::cout << tree.min_cut(u - 1, v - 1) << "\n";
+    }
     return 0;
 }
 
-int benchmark_mode(Algorithm algo, const char* input_path, const char* output_name)
+// A benchmark graph together with the counters recorded while loading it
+struct BenchmarkInstance {
+    Graph graph;
+    PerfStats load_perf;
+    MemoryStats parse_memory;
+};
+
+int benchmark_mode(Algorithm algo, const char* input_path, const char* output_name,
+                   const SolverOptions& options)
 {
     const int num_runs = 10;
+    PerfCounters perf;
+    PerfCounters* run_perf = options.perf ? &perf : nullptr;
+    if (options.perf && !perf.is_available()) {
+        std::cerr << "Warning: hardware counters unavailable, perf columns will be zero\n";
+    }
+
+    // Allocations are only counted when asked for
+    std::unique_ptr<MemoryCounters> memory;
+    if (options.memory)
+        memory = std::make_unique<MemoryCounters>();
 
     // Read all .graph files from the input folder into memory
-    std::vector<Graph> graphs;
+    std::vector<BenchmarkInstance> instances;
     for (const auto& entry : std::filesystem::directory_iterator(input_path)) {
         if (entry.is_regular_file() && entry.path().extension() == ".graph") {
             std::ifstream input(entry.path());
             if (!input.is_open()) {
                 continue;  // Skip the current file if it can't be opened
             }
+            perf.reset();
+            perf.start();
+            if (memory) {
+                memory->reset();
+                memory->start();
+            }
             Graph graph(input);
-            graphs.push_back(std::move(graph));
+            if (options.memory)
+                report_memory(graph, entry.path().filename().string());
+            if (!check_terminal_sets(graph, algo, options, entry.path().filename().string()))
+                continue;
+            if (options.order != VertexOrder::Input)
+                graph.reorder_vertices(options.order);
+            if (options.preprocess) {
+                ReducedGraph reduced(graph);
+                report_reduction(reduced.get_reduction_stats(), entry.path().filename().string());
+                graph = std::move(reduced);
+            }
+            perf.stop(Phase::Load);
+            if (memory)
+                memory->stop(MemoryPhase::Parse);
+            instances.push_back(BenchmarkInstance{std::move(graph), perf.get_stats(),
+                                                  memory ? memory->get_stats() : MemoryStats{}});
         }
     }
 
     // Sort the graphs by the number of vertices first, then by the number of arcs if vertices are
     // equal
-    std::sort(graphs.begin(), graphs.end(), [](const Graph& a, const Graph& b) {
-        if (a.get_total_vertices() == b.get_total_vertices()) {
-            return a.get_total_arcs() < b.get_total_arcs();  // Compare arcs if vertices are equal
-        }
-        return a.get_total_vertices() < b.get_total_vertices();  // Otherwise, compare vertices
-    });
+    std::sort(instances.begin(), instances.end(),
+              [](const BenchmarkInstance& a, const BenchmarkInstance& b) {
+                  const Graph &ga = a.graph, &gb = b.graph;
+                  if (ga.get_total_vertices() == gb.get_total_vertices()) {
+                      // Compare arcs if vertices are equal
+                      return ga.get_total_arcs() < gb.get_total_arcs();
+                  }
+                  // Otherwise, compare vertices
+                  return ga.get_total_vertices() < gb.get_total_vertices();
+              });
 
     // Construct the output file path
     std::filesystem::path output_dir = "./data/outputs/";
@@ -79,24 +565,74 @@ int benchmark_mode(Algorithm algo, const char* input_path, const char* output_na
         return -1;  // Return an error if output file can't be created
     }
 
-    Logger::log_stats_header(algo, output_file);
+    Logger::log_stats_header(algo, output_file, options.perf, options.memory);
 
     // Run and log stats of each graph over the selected algorithm
-    for (auto& graph : graphs) {
+    for (auto& instance : instances) {
         GraphMetrics total_metrics = {0};
+        Graph& graph = instance.graph;
+        const int source = graph.has_terminal_sets() ? ALL_TERMINALS : graph.get_source();
+        const int sink = graph.has_terminal_sets() ? ALL_TERMINALS : graph.get_sink();
         for (int i = 0; i < num_runs; ++i) {
-            Graph copy_graph(&graph);
-            FordResult result = ford_fulkerson(copy_graph, copy_graph.get_source(),
-                                               copy_graph.get_sink(), algo, true);
-            GraphMetrics run_metrics = Metrics::compute_graph_metrics(copy_graph, algo, result);
+            // Restore the residual capacities left by the previous run
+            perf.reset();
+            perf.start();
+            if (memory) {
+                memory->reset();
+                memory->start();
+            }
+            graph.reset_residual();
+            perf.stop(Phase::Copy);
+            if (memory) {
+                memory->stop(MemoryPhase::Copy);
+                memory->start();
+            }
+
+            FordResult result =
+                solve_max_flow(graph, source, sink, algo, true, run_perf, options.seed + i);
+
+            if (memory) {
+                memory->stop(MemoryPhase::Solve);
+                memory->start();
+            }
+            perf.start();
+            GraphMetrics run_metrics = Metrics::compute_graph_metrics(graph, algo, result);
+            perf.stop(Phase::Metrics);
+            if (memory)
+                memory->stop(MemoryPhase::Metrics);
+
+            run_metrics.perf = perf.get_stats();
+            if (memory)
+                run_metrics.memory = memory->get_stats();
             total_metrics.increment(run_metrics);
         }
 
         // Average the accumulated metrics over the number of runs
         total_metrics.average(num_runs);
 
+        // Compare the alternative engines against one run of each classic
+        // serial engine
+        if (algo == Algorithm::ParallelPushRelabel || algo == Algorithm::BoykovKolmogorov) {
+            const double engine_time = std::max(1.0, total_metrics.time_ms);
+            graph.reset_residual();
+            total_metrics.speedup_ek =
+                ford_fulkerson(graph, graph.get_source(), graph.get_sink(),
+                               Algorithm::EdmondsKarp, false)
+                    .duration_ms /
+                engine_time;
+            graph.reset_residual();
+            total_metrics.speedup_fp =
+                ford_fulkerson(graph, graph.get_source(), graph.get_sink(),
+                               Algorithm::FattestPath, false)
+                    .duration_ms /
+                engine_time;
+        }
+        total_metrics.perf.increment(instance.load_perf);
+        total_metrics.memory.increment(instance.parse_memory);
+
         // Log the averaged metrics for this graph
-        Logger::log_instance_stats(total_metrics, algo, output_file);
+        Logger::log_instance_stats(total_metrics, algo, output_file, options.perf,
+                                   options.memory);
     }
 
     return 0;
@@ -104,12 +640,79 @@ int benchmark_mode(Algorithm algo, const char* input_path, const char* output_na
 
 int main(int argc, char const* argv[])
 {
+    // Split optional flags from positional arguments
+    SolverOptions options;
+    std::vector<const char*> args = {argv[0]};
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--perf") {
+            options.perf = true;
+        } else if (arg == "--timing") {
+            options.timing = true;
+        } else if (arg == "--preprocess") {
+            options.preprocess = true;
+        } else if (arg == "--memory") {
+            options.memory = true;
+        } else if (arg == "--compressed") {
+            options.compressed = true;
+        } else if (arg == "--reorder=bfs") {
+            options.order = VertexOrder::Bfs;
+        } else if (arg == "--reorder=rcm") {
+            options.order = VertexOrder::ReverseCuthillMcKee;
+        } else if (arg.rfind("--seed=", 0) == 0) {
+            char* end = nullptr;
+            options.seed = std::strtoull(arg.c_str() + 7, &end, 10);
+            if (end == arg.c_str() + 7 || *end != '\0')
+                return display_usage_tutorial(argv[0]);
+        } else if (arg.rfind("--target=", 0) == 0) {
+            char* end = nullptr;
+            long target = std::strtol(arg.c_str() + 9, &end, 10);
+            if (end == arg.c_str() + 9 || *end != '\0' || target < 0 || target >= NO_TARGET)
+                return display_usage_tutorial(argv[0]);
+            options.target = target;
+        } else if (arg.rfind("--checkpoint=", 0) == 0) {
+            options.checkpoint_path = arg.substr(13);
+        } else if (arg.rfind("--checkpoint-every=", 0) == 0) {
+            char* end = nullptr;
+            long every = std::strtol(arg.c_str() + 19, &end, 10);
+            if (end == arg.c_str() + 19 || *end != '\0' || every <= 0 || every >= NO_TARGET)
+                return display_usage_tutorial(argv[0]);
+            options.checkpoint_every = every;
+        } else if (arg.rfind("--checkpoint-seconds=", 0) == 0) {
+            char* end = nullptr;
+            options.checkpoint_seconds = std::strtod(arg.c_str() + 21, &end);
+            if (end == arg.c_str() + 21 || *end != '\0' || !(options.checkpoint_seconds > 0))
+                return display_usage_tutorial(argv[0]);
+        } else if (arg == "--resume") {
+            options.resume = true;
+        } else if (arg.rfind("--batch=", 0) == 0) {
+            options.batch_path = arg.substr(8);
+        } else if (arg.rfind("--gomory-hu=", 0) == 0) {
+            options.tree_path = arg.substr(12);
+        } else if (arg.rfind("--cut-tree=", 0) == 0) {
+            options.query_path = arg.substr(11);
+        } else if (arg.rfind("--serve=", 0) == 0) {
+            options.serve_path = arg.substr(8);
+        } else if (arg.rfind("--trace=", 0) == 0) {
+            options.trace_path = arg.substr(8);
+        } else if (arg.rfind("--", 0) == 0) {
+            return display_usage_tutorial(argv[0]);
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+    argc = args.size();
+
+    if (argc == 1 && !options.query_path.empty()) {
+        return cut_tree_mode(options);
+    }
+
     if (argc != 2 && argc != 4) {
         return display_usage_tutorial(argv[0]);
     }
 
     Algorithm algo;
-    switch (std::stoi(argv[1])) {
+    switch (std::stoi(args[1])) {
         case 0:
             algo = Algorithm::EdmondsKarp;
             break;
@@ -119,16 +722,58 @@ int main(int argc, char const* argv[])
         case 2:
             algo = Algorithm::FattestPath;
             break;
+        case 3:
+            algo = Algorithm::ParallelEdmondsKarp;
+            break;
+        case 4:
+            algo = Algorithm::ParallelPushRelabel;
+            break;
+        case 5:
+            algo = Algorithm::BoykovKolmogorov;
+            break;
+        case 6:
+            algo = Algorithm::Pseudoflow;
+            break;
         default:
             return display_usage_tutorial(argv[0]);
     }
 
-    if (argc == 2) {
-        return single_run_mode(algo);
-    }
+    // Inputs without a source or sink are rejected while being read
+    try {
+        if (argc == 2 && !options.batch_path.empty()) {
+            return batch_mode(algo, options);
+        }
+
+        if (argc == 2 && !options.tree_path.empty()) {
+            return gomory_hu_mode(algo, options);
+        }
+
+        if (argc == 2 && !options.serve_path.empty()) {
+            return service_mode(algo, options);
+        }
 
-    if (argc == 4) {
-        return benchmark_mode(algo, argv[2], argv[3]);
+        // Checkpoints hold the residual graph of an augmenting path solve
+        if (options.resume && options.checkpoint_path.empty())
+            return display_usage_tutorial(argv[0]);
+        if (!options.checkpoint_path.empty() && !has_augmenting_loop(algo)) {
+            std::cerr << "Error: --checkpoint needs an augmenting path algorithm (0-3)\n";
+            return -1;
+        }
+
+        if (argc == 2 && options.compressed) {
+            return compressed_run_mode(algo, options);
+        }
+
+        if (argc == 2) {
+            return single_run_mode(algo, options);
+        }
+
+        if (argc == 4) {
+            return benchmark_mode(algo, args[2], args[3], options);
+        }
+    } catch (const std::invalid_argument& error) {
+        std::cerr << "Error: " << error.what() << "\n";
+        return -1;
     }
 
     return -1;
@@ -31,9 +31,12 @@ int single_run_mode()
         return 0;
     }
 
-    ford_fulkerson(graph, graph.get_source(), graph.get_sink(), Algorithm::FattestPath, false);
+    // Only whether the flow reaches C matters, not the max flow itself
+    const int games = graph.get_remaining_games();
+    FordResult result = solve_max_flow_until(graph, graph.get_source(), graph.get_sink(),
+                                             Algorithm::FattestPath, games, false);
 
-    if (graph.team_one_can_win_after_flow()) {
+    if (result.max_flow >= games) {
         std::cout << "sim" << std::endl;
     } else {
         std::cout << "não" << std::endl;
@@ -82,9 +85,11 @@ int benchmark_mode(const char* folder_path, const char* output_name)
 
             bool winnable = false;
             if (graph.team_one_can_win_before_flow()) {
-                ford_fulkerson(graph, graph.get_source(), graph.get_sink(), Algorithm::FattestPath,
-                               false);
-                winnable = graph.team_one_can_win_after_flow();
+                const int games = graph.get_remaining_games();
+                FordResult result = solve_max_flow_until(graph, graph.get_source(),
+                                                         graph.get_sink(), Algorithm::FattestPath,
+                                                         games, false);
+                winnable = result.max_flow >= games;
             }
 
             auto end = std::chrono::high_resolution_clock::now();